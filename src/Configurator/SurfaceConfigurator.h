@@ -44,6 +44,7 @@ namespace Configurator{
       public:
          explicit Surface(Layer::Surface&);
          void setArea(double const);
+         void syncIsovalue();
 
       public Q_SLOTS:
          void sync();
@@ -58,6 +59,7 @@ namespace Configurator{
          void on_linesButton_clicked(bool);
          void on_dotsButton_clicked(bool);
          void on_transparencySlider_valueChanged(int);
+         void on_isovalueSlider_valueChanged(int);
          void on_clipCheckBox_clicked(bool);
          void editGradientColors(bool);
 
@@ -68,6 +70,7 @@ namespace Configurator{
          void setPositiveColor(QList<QColor> const& colors);
          void setNegativeColor(QColor const& color);
          void updateScale();
+         double sliderToIsovalue(int const value) const;
 
          Layer::Surface& m_surface;
          QList<QColor> m_gradientColors;
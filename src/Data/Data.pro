@@ -4,6 +4,9 @@ include(../common.pri)
 
 INCLUDEPATH += ../Util ../Parser ../Yaml ../OpenMesh/src 
 
+# Allows the Shell evaluation kernels to be vectorized at -O2
+*-g++*:QMAKE_CXXFLAGS += -ftree-vectorize -fno-trapping-math
+
 SOURCES = \
    $$PWD/Atom.C \
    $$PWD/AtomicProperty.C \
@@ -28,6 +31,7 @@ SOURCES = \
    $$PWD/GridSize.C \
    $$PWD/Hessian.C \
    $$PWD/Mesh.C \
+   $$PWD/MinMaxOctree.C \
    $$PWD/MultipoleExpansion.C \
    $$PWD/NaturalBondOrbitals.C \
    $$PWD/NaturalTransitionOrbitals.C \
@@ -42,6 +46,7 @@ SOURCES = \
    $$PWD/PovRay.C \
    $$PWD/RemSectionData.C \
    $$PWD/Shell.C \
+   $$PWD/ShellIndex.C \
    $$PWD/ShellList.C \
    $$PWD/Surface.C \
    $$PWD/SurfaceInfo.C \
@@ -78,6 +83,7 @@ HEADERS = \
    $$PWD/Hessian.h \
    $$PWD/LocalizedOrbitals.h \
    $$PWD/Mesh.h \
+   $$PWD/MinMaxOctree.h \
    $$PWD/MultipoleExpansion.h \
    $$PWD/NaturalBondOrbitals.h \
    $$PWD/NaturalTransitionOrbitals.h \
@@ -94,6 +100,7 @@ HEADERS = \
    $$PWD/RemSectionData.h \
    $$PWD/Serialization.h \
    $$PWD/Shell.h \
+   $$PWD/ShellIndex.h \
    $$PWD/ShellList.h \
    $$PWD/Surface.h \
    $$PWD/SurfaceInfo.h \
@@ -23,6 +23,7 @@
 ********************************************************************************/
 
 #include "DataList.h"
+#include "Matrix.h"
 #include "SurfaceType.h"
 
 
@@ -53,6 +54,18 @@ namespace Data {
 
          Vector* vector() { return &m_elements; }
 
+		 /// Optionally records the density in terms of orbitals, P = C^T W C,
+		 /// where the rows of C are the orbital coefficients and W is the 
+		 /// diagonal matrix of weights.  When the number of orbitals is small
+		 /// compared to the number of significant basis functions this allows
+         /// the density to be evaluated more cheaply on a grid.  These are 
+         /// derived data and are not serialized.
+         void setOrbitals(Matrix const& coefficients, QList<double> const& weights);
+
+         bool hasOrbitals() const { return !m_orbitalWeights.isEmpty(); }
+         Matrix const& orbitalCoefficients() const { return m_orbitalCoefficients; }
+         QList<double> const& orbitalWeights() const { return m_orbitalWeights; }
+
          void serialize(InputArchive& ar, unsigned const version = 0) 
          {
             privateSerialize(ar, version);
@@ -79,6 +92,9 @@ namespace Data {
          QString     m_label;
          unsigned    m_nBasis;
          Vector      m_elements;
+
+         Matrix        m_orbitalCoefficients;
+         QList<double> m_orbitalWeights;
    };
 
    class DensityList : public Data::List<Data::Density> { };
@@ -27,27 +27,52 @@
 #include "SurfaceType.h"
 #include "Geometry.h"
 #include "Matrix.h"
+#include <QVector>
+#include <QMutex>
+
+
+class QDataStream;
 
 
 namespace IQmol {
 namespace Data {
 
    class GridSize;
+   class MinMaxOctree;
 
    /// Basic Data class for holding real data on a 3D grid.
+   ///
+   /// Grids are created and written to in double precision, but once the
+   /// data are complete they can be moved to a more compact storage with
+   /// setPrecision().  Single precision halves the memory and Quantized
+   /// stores each value in 16 bits as offset + scale*q, a quarter of the
+   /// memory, where the offset and scale span the range of the data.  
+   /// Density grids, and grids where the quantization step would be 
+   /// significant compared to the isovalues, are stored in single precision
+   /// instead of being quantized.  The accessors read transparently from any
+   /// storage, but the data can only be written through element() while the
+   /// grid is in double precision.
    class GridData : public Base {
 
       using Base::copy;
       friend class boost::serialization::access;
 
       public:
+         enum Precision { Double = 0, Single, Quantized };
+
          Type::ID typeID() const { return Type::GridData; }
 
          GridData(GridSize const&, SurfaceType const&);
          GridData(GridSize const&, SurfaceType const&, QList<double> const& data);
          GridData(GridData const&);
 
-         GridData() { }  // for boost::serialize;
+		 /// Reads the values from a stream written by writeValues() on a grid
+		 /// of the same size.  Throws if the stream does not match the size.
+         GridData(GridSize const&, SurfaceType const&, QDataStream&);
+
+         GridData() : m_nx(0), m_ny(0), m_nz(0), m_precision(Double), m_scale(0.0), 
+            m_offset(0.0), m_octree(0) { }  // for boost::serialize;
+         ~GridData();
 
          void getNumberOfPoints(unsigned& nx, unsigned& ny, unsigned& nz) const;
 
@@ -57,6 +82,17 @@ namespace Data {
 
          double dataSizeInKb() const;
 
+         Precision precision() const { return m_precision; }
+
+         /// Converts the data to the given storage.  Note this is lossy for
+         /// anything other than Double and converting back does not recover
+         /// the original values.  Quantized falls back to Single if the grid 
+         /// cannot be quantized without affecting its surfaces.
+         void setPrecision(Precision);
+
+         /// Writes the values, in their current storage, to the stream.
+         void writeValues(QDataStream&) const;
+
          SurfaceType const& surfaceType() const { return m_surfaceType; }
 
          void setSurfaceType(SurfaceType::Kind const& kind) { m_surfaceType.setKind(kind); }
@@ -69,19 +105,54 @@ namespace Data {
 
          bool saveToCubeFile(QString const& filePath, QStringList const& coordinates,
             bool const invertSign) const;
+
+		 /// Grids may be evaluated adaptively, in which case the data are only
+		 /// accurate in the vicinity of the given isovalues and are interpolated
+		 /// elsewhere.  An empty list indicates the data are accurate everywhere.
+         /// Note these are not serialized.
+         void setIsovalues(QList<double> const& isovalues) { m_isovalues = isovalues; }
+         QList<double> const& isovalues() const { return m_isovalues; }
+
+         /// Returns true if the grid data are suitable for generating a surface
+         /// with the given isovalue.
+         bool resolves(double const isovalue) const {
+            return resolves(m_isovalues, isovalue);
+         }
+
+         static bool resolves(QList<double> const& isovalues, double const isovalue);
+
+		 /// Returns true if values quantized with the given step are accurate
+		 /// enough for the surfaces of the grid.
+         bool canQuantize(double const step) const;
            
          GridData& operator=(GridData const& that);
          GridData& operator+=(GridData const& that);
          GridData& operator-=(GridData const& that);
          GridData& operator*=(double const that);
 
-         double const& operator()(unsigned const i, unsigned const j, unsigned const k) const
+         double value(unsigned const i, unsigned const j, unsigned const k) const
          {
-            return m_data[i][j][k];
+            switch (m_precision) {
+               case Single:
+                  return m_single.constData()[(i*m_ny + j)*m_nz + k];
+               case Quantized:
+                  return m_offset + m_scale*m_quantized.constData()[(i*m_ny + j)*m_nz + k];
+               default:
+                  return m_data[i][j][k];
+            }
+         }
+
+         double operator()(unsigned const i, unsigned const j, unsigned const k) const
+         {
+            return value(i, j, k);
          }
 
-         double& operator()(unsigned const i, unsigned const j, unsigned const k)
+		 /// Write access to the data.  The grid must still be in double
+		 /// precision, i.e. setPrecision() has not moved it to a more
+		 /// compact storage.
+         double& element(unsigned const i, unsigned const j, unsigned const k)
          {
+            Q_ASSERT(m_precision == Double);
             return m_data[i][j][k];
          }
 
@@ -98,20 +169,50 @@ namespace Data {
          // computes this = a*this + b*B
          void combine(double const a, double const b, GridData const& B);
 
+		 /// Returns the min/max octree over the data, building it on first
+		 /// use.  This is used to skip the parts of the grid that cannot
+		 /// contain a given isosurface.  If the data are modified through
+         /// element() after this has been called, dataChanged() must be
+         /// called to invalidate the tree.  The tree reflects the storage at
+         /// the time it is built, so it should be built after setPrecision().
+         MinMaxOctree const& octree() const;
+         void dataChanged();
+
          void serialize(InputArchive& ar, unsigned const version = 0) 
          {
             privateSerialize(ar, version);
+            // Archives hold double precision data, so any compact storage
+            // left over from before is stale
+            m_precision = Double;
+            m_single.clear();
+            m_quantized.clear();
+            m_scale  = 0.0;
+            m_offset = 0.0;
+            m_nx = m_data.shape()[0];
+            m_ny = m_data.shape()[1];
+            m_nz = m_data.shape()[2];
+            dataChanged();
          }
 
+         /// Archives are always written in double precision
          void serialize(OutputArchive& ar, unsigned const version = 0) 
          {
-            privateSerialize(ar, version);
+            if (m_precision == Double) {
+               privateSerialize(ar, version);
+            }else {
+               GridData grid(*this);
+               grid.setPrecision(Double);
+               grid.privateSerialize(ar, version);
+            }
          }
 
          void dump() const;
 
       private:
+         static double const s_quantizationTolerance;
+
          void copy(GridData const&);
+         bool readValues(QDataStream&);
 
          template <class Archive>
          void privateSerialize(Archive& ar, unsigned const) 
@@ -125,7 +226,19 @@ namespace Data {
          SurfaceType m_surfaceType;
          qglviewer::Vec m_origin;
          qglviewer::Vec m_delta;
+         unsigned m_nx, m_ny, m_nz;
+
+         // Only one of these holds the data, depending on the precision
+         Precision m_precision;
          Array3D m_data;
+         QVector<float> m_single;
+         QVector<quint16> m_quantized;
+         double m_scale;
+         double m_offset;
+
+         QList<double> m_isovalues;
+         mutable MinMaxOctree* m_octree;
+         mutable QMutex m_octreeMutex;
    };
 
 
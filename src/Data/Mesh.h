@@ -27,11 +27,13 @@
 #include "OpenMesh/Core/IO/Options.hh"
 #include "OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh"
 #include <QPair>
+#include <QVector>
 
 
 namespace IQmol {
 
 class MeshDecimator;
+class MeshBuffer;
 
 namespace Parser {
    class Mesh;
@@ -58,6 +60,7 @@ namespace Data {
       friend class boost::serialization::access;
       friend class IQmol::Parser::Mesh;
       friend class IQmol::MeshDecimator;
+      friend class IQmol::MeshBuffer;
       friend class IQmol::Layer::Surface;
 
     public:
@@ -83,6 +86,12 @@ namespace Data {
          Vertex addVertex(double const x, double const y, double const z);
          Face   addFace(Vertex const& v0, Vertex const& v1, Vertex const& v2);
 
+         /// Avoids repeated reallocation when building large meshes.
+         void reserve(unsigned const nVertices, unsigned const nFaces);
+
+         /// Removes all the vertices and faces, the properties are kept.
+         void clear();
+
          void setNormal(Vertex const& handle, double dx, double dy, double dz);
          void setNormal(Vertex const& handle, Normal const& normal);
          void setPoint(Vertex const& handle, Point const& p);
@@ -111,6 +120,10 @@ namespace Data {
          void deleteProperty(Property const property);
 
          bool computeScalarField(Function3D const&);
+
+		 /// Evaluates the field over blocks of vertices, which are shared out
+         /// between the Scheduler's worker threads.
+         bool computeScalarField(BlockFunction3D const&);
          bool computeIndexField();
 
          void getScalarFieldRange(double& min, double& max);
@@ -122,6 +135,10 @@ namespace Data {
          /// identity of the individual meshes is still required.
          bool setMeshIndex(int const index);
 
+         /// Sets the MeshIndex of a single face, the property must already
+         /// have been requested.
+         void setMeshIndex(Face const& face, int const index);
+
          int meshIndex(Face const& face) const;
 
          void serialize(InputArchive& ar, unsigned const version = 0);
@@ -135,6 +152,16 @@ namespace Data {
 
          double surfaceArea() const;
 
+		 /// Coarser versions of the mesh recorded by the MeshDecimator, from
+		 /// fine to coarse.  Each level is a list of triangles given by the
+		 /// indices of their vertices in this mesh, so the vertex data can be
+		 /// shared.  These are not serialized and are discarded whenever the
+         /// faces are changed.
+         QList<QVector<unsigned> > const& levelsOfDetail() const 
+         { 
+            return m_levelsOfDetail; 
+         }
+
          void dump() const;
 
       protected:
@@ -191,6 +218,8 @@ namespace Data {
 		 /// Property handle for atom indices.  This is used for coloring the
 		 /// mesh based on atomic properties such as element number or charge.
          OpenMesh::FPropHandleT<int>    m_meshIndexHandle;
+
+         QList<QVector<unsigned> > m_levelsOfDetail;
    };
 
    typedef Data::List<Data::Mesh> MeshList;
@@ -0,0 +1,76 @@
+#ifndef IQMOL_DATA_MINMAXOCTREE_H
+#define IQMOL_DATA_MINMAXOCTREE_H
+/*******************************************************************************
+         
+  Copyright (C) 2011-2015 Andrew Gilbert
+      
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+         
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software  
+  Foundation, either version 3 of the License, or (at your option) any later  
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+      
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+   
+********************************************************************************/
+
+#include <QList>
+#include <QVector>
+
+
+namespace IQmol {
+namespace Data {
+
+   class GridData;
+
+   /// Implicit octree holding the minimum and maximum values over blocks of
+   /// grid cells.  The leaves are bricks of up to BrickSize^3 cells and each
+   /// level above merges 2x2x2 nodes of the level below.  This allows the
+   /// cells that may be cut by an isosurface to be found without visiting
+   /// every point of the grid.
+   class MinMaxOctree {
+
+      public:
+         /// Number of cells along each side of a brick
+         static unsigned const BrickSize = 8;
+
+         MinMaxOctree(GridData const& grid);
+
+         void getNumberOfBricks(unsigned& nx, unsigned& ny, unsigned& nz) const;
+
+         /// Range of the data over the whole grid
+         void getRange(double& min, double& max) const;
+
+		 /// Flags the bricks that contain cells that may straddle any of the
+		 /// isovalues, i.e. those where min <= isovalue < max.  The flags are 
+		 /// indexed as (i*ny + j)*nz + k and the number of bricks found is 
+         /// returned.
+         unsigned findBricks(QList<double> const& isovalues, QVector<char>& active) const;
+
+      private:
+         struct Level {
+            unsigned nx, ny, nz;
+            QVector<double> min;
+            QVector<double> max;
+         };
+
+         void buildBricks(GridData const& grid);
+         void buildLevel(Level const& child);
+         unsigned search(unsigned const level, unsigned const i, unsigned const j, 
+            unsigned const k, QList<double> const& isovalues, QVector<char>& active) const;
+
+         // Level 0 holds the bricks, the last level has a single node
+         QList<Level> m_levels;
+   };
+
+} } // end namespace IQmol::Data
+
+#endif
@@ -24,6 +24,7 @@
 
 #include "QGLViewer/vec.h"
 #include "Data.h"
+#include <QVector>
 
 
 namespace IQmol {
@@ -60,20 +61,45 @@ namespace Data {
             double const thresh = 0.001);
 
 		 // Returns a pointer to an array containing the values of the basis
-		 // functions at the given position.
+		 // functions at the given position.  These use a static buffer which 
+         // is overwritten on each call and so are not thread safe.
          double const* evaluate(qglviewer::Vec const& gridPoint) const;
          double const* evaluate(double const x, double const y, double const z) const;
 
+		 /// Reentrant version of evaluate that writes the basis function values
+		 /// into the caller-supplied array, which must have room for nBasis()
+		 /// values.  Returns values, or a null pointer if the point lies outside 
+         /// the significant radius of the Shell.
+         double const* evaluate(double const x, double const y, double const z,
+            double* values) const;
+
+		 /// Evaluates the Shell at n grid points.  The nBasis() values for 
+		 /// point p are written to values[p*stride], and are zero for points
+		 /// beyond the significant radius.  Returns false if none of the 
+         /// points are within the significant radius.
+         bool evaluate(unsigned const n, double const* x, double const* y, 
+            double const* z, double* values, unsigned const stride) const;
+
+         /// Number of points handled by each pass of the vectorized kernels.
+         static unsigned const BlockLength = 64;
+
          AngularMomentum angularMomentum() const { return m_angularMomentum; }
 
          unsigned atomIndex() const { return m_atomIndex; }
 
+         qglviewer::Vec const& position() const { return m_position; }
+
+		 /// Returns the square of the radius beyond which the Shell is taken
+         /// to be zero by evaluate().
+         double significantRadiusSquared() const { return m_significantRadiusSquared; }
+
          unsigned nBasis() const;
 
          QString label(unsigned const) const;
 
          void serialize(InputArchive& ar, unsigned int const version = 0) {
             privateSerialize(ar, version);
+            pack();
          }  
          
          void serialize(OutputArchive& ar, unsigned int const version = 0) {
@@ -84,9 +110,9 @@ namespace Data {
          void dump() const;
 
       private:
-		 /// Shell values are stored in this static array, the length of which
-		 /// is sufficient for up to g angular momentum.  This could cause 
-         /// problems if Shells are ever used in parallel.
+		 /// Shell values for the non-reentrant evaluate functions are stored in
+		 /// this static array, the length of which is sufficient for up to g 
+         /// angular momentum.
          static double s_values[15];
          static double s_zeroValues[15];
 
@@ -97,6 +123,10 @@ namespace Data {
          double computeSignificantRadius(double const thresh);
          void normalize();
 
+		 /// Copies the exponents and contraction coefficients into the
+         /// contiguous arrays used by the evaluation kernels.
+         void pack();
+
          template <class Archive>
          void privateSerialize(Archive& ar, unsigned const) {
             ar & m_angularMomentum;
@@ -113,6 +143,9 @@ namespace Data {
          QList<double>   m_exponents;
          QList<double>   m_contractionCoefficients;
          double          m_significantRadiusSquared;
+
+         QVector<double> m_alpha;
+         QVector<double> m_coefficient;
    };
 
 
@@ -0,0 +1,72 @@
+#ifndef IQMOL_DATA_SHELLINDEX_H
+#define IQMOL_DATA_SHELLINDEX_H
+/*******************************************************************************
+         
+  Copyright (C) 2011-2015 Andrew Gilbert
+      
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+         
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software  
+  Foundation, either version 3 of the License, or (at your option) any later  
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+      
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+   
+********************************************************************************/
+
+#include "QGLViewer/vec.h"
+#include <QVector>
+
+
+namespace IQmol {
+namespace Data {
+
+   class ShellList;
+
+   /// Uniform cell list over the significant regions of the Shells in a
+   /// ShellList.  Each Shell is binned into every cell that its significant
+   /// sphere overlaps, so a query only needs to look at the cells covered by
+   /// the region of interest.  The index is a snapshot of the significant 
+   /// radii at construction, so it must be rebuilt if the threshold used for
+   /// ShellList::boundingBox changes.  Queries are const and may be made from
+   /// several threads at once.
+   class ShellIndex {
+
+      public:
+         ShellIndex(ShellList const&);
+
+		 /// Returns, in ascending order, the indices of the Shells whose
+		 /// significant region intersects the box defined by min and max.
+         void query(qglviewer::Vec const& min, qglviewer::Vec const& max, 
+            QVector<unsigned>& shells) const;
+
+         unsigned nShells() const { return m_centers.size(); }
+
+      private:
+         void cellRange(qglviewer::Vec const& min, qglviewer::Vec const& max,
+            int& i0, int& j0, int& k0, int& i1, int& j1, int& k1) const;
+
+         qglviewer::Vec m_origin;
+         double m_cellSize;
+         int m_nx, m_ny, m_nz;
+
+         QVector<qglviewer::Vec> m_centers;
+         QVector<double> m_radiiSquared;
+
+         // Compressed cell list: the Shells in cell c are given by 
+         // m_cellShells[m_cellOffsets[c]] ... m_cellShells[m_cellOffsets[c+1]-1]
+         QVector<unsigned> m_cellOffsets;
+         QVector<unsigned> m_cellShells;
+   };
+
+} } // end namespace IQmol::Data
+
+#endif
@@ -26,6 +26,9 @@
 #include "DataList.h"
 #include "Matrix.h"
 #include "Shell.h"
+#include "ShellIndex.h"
+#include <QVector>
+#include <QPair>
 
 
 namespace IQmol {
@@ -45,23 +48,79 @@ namespace Data {
       QList<double>   overlapMatrix;
    };
 
+   class EvaluationContext;
+
+
+   /// Orbital coefficients packed for the block evaluation functions of an
+   /// EvaluationContext.  The rows of the selected orbitals are transposed
+   /// to an nBasis x nOrbitals array so that the coefficients of the basis
+   /// functions used in a block are contiguous.  The data are only read 
+   /// during evaluation, so one instance can be shared by the contexts of 
+   /// all the worker threads.
+   class PackedOrbitals {
+
+      public:
+         PackedOrbitals(unsigned const nBasis = 0) : m_nBasis(nBasis), m_nOrbitals(0) { }
+
+		 /// Appends the given rows of the coefficient matrix.  Returns false,
+		 /// leaving the orbitals unchanged, if the rows do not fit.
+         bool append(Matrix const& coefficients, QList<int> const& indices);
+
+		 /// Appends all the rows of the coefficient matrix along with their
+		 /// weights, as for a density P = C^T W C.
+         bool append(Matrix const& coefficients, QList<double> const& weights);
+
+         void clear();
+
+         unsigned nBasis() const { return m_nBasis; }
+         unsigned nOrbitals() const { return m_nOrbitals; }
+
+         /// The coefficients of all the orbitals for the given basis function.
+         double const* row(unsigned const basis) const { 
+            return m_coefficients.data() + basis*m_nOrbitals;
+         }
+
+         /// Unit weights unless given when appending.
+         double const* weights() const { return m_weights.data(); }
+
+      private:
+         bool append(Matrix const& coefficients, QList<int> const& indices,
+            QList<double> const& weights);
+
+         unsigned m_nBasis;
+         unsigned m_nOrbitals;
+         QVector<double> m_coefficients;
+         QVector<double> m_weights;
+   };
+
+
    class ShellList : public List<Shell> {
 
       friend class boost::serialization::access;
+      friend class EvaluationContext;
 
       public:
-         ShellList() { }
+         ShellList() : m_context(0), m_shellIndex(0) { }
 
          ShellList(ShellData const& shellData, Geometry const& geometry);
 
+         ShellList(ShellList const&);
+
+         ShellList& operator=(ShellList const&);
+
          ~ShellList();
 
          /// Returns the (-1,-1,-1) and (1,1,1) octant corners of a rectangular
          /// box that encloses the significant region of the Shells where 
-         /// significance is determined by thresh.  
+         /// significance is determined by thresh.  This also (re)builds the
+         /// spatial index of the Shells for the given threshold.
          void boundingBox(qglviewer::Vec& min, qglviewer::Vec& max, 
             double const thresh = 0.001);
 
+		 /// Returns the spatial index built by the last call to boundingBox,
+         /// or a null pointer if boundingBox has not been called.
+         ShellIndex const* shellIndex() const { return m_shellIndex; }
+
          unsigned nBasis() const;
 
          Vector const& overlapMatrix() const { return m_overlapMatrix; }
@@ -79,6 +138,9 @@ namespace Data {
          /// to the list and before shellValues or shellPairValues is called.
          void resize();
 
+		 // The following evaluation functions use a workspace owned by the
+		 // ShellList and are therefore not reentrant.  Use an EvaluationContext
+         // for evaluating the same ShellList from more than one thread.
          Vector const& shellValues(double const x, double const y, double const z);
          Vector const& shellValues(qglviewer::Vec const& gridPoint);
 
@@ -118,20 +180,147 @@ namespace Data {
          void dump() const;
 
       private:
+         EvaluationContext& context();
+
+         Vector m_overlapMatrix;   // upper triangular
+
+         // Workspace for the non-reentrant evaluation functions, created on
+         // first use and never shared between copies of the ShellList.
+         EvaluationContext* m_context;
+
+         ShellIndex* m_shellIndex;
+
+         Vector m_basisPairValues;  // Deprecate
+   };
+
+
+   /// Per-caller workspace for evaluating a ShellList at grid points.  The
+   /// ShellList is only read during the evaluation, so any number of threads
+   /// can evaluate the same ShellList concurrently provided each uses its own
+   /// EvaluationContext.  The ShellList (and any coefficient matrices or 
+   /// density vectors set on the context) must outlive the context.
+   class EvaluationContext {
+
+      public:
+         EvaluationContext(ShellList const&);
+
+         ShellList const& shellList() const { return m_shellList; }
+
+         // Selects the basis functions returned by basisValues.
+         void setBasisIndices(QList<int> const& indices);
+
+		 // Initializes the list of densities to be evaluated a grid points
+		 // with subsequent densityValues calls.
+         void setDensityVectors(QList<Vector const*> const& densities);
+
+		 // Optionally supplies density k (in the list passed to setDensityVectors)
+		 // in terms of weighted orbitals, P = C^T W C.  densityBlock then uses
+		 // whichever of the orbitals or the density matrix is cheaper for each
+         // block.  The orbitals are not copied and must outlive the context.
+         void setDensityOrbitals(unsigned const k, PackedOrbitals const* orbitals);
+
+		 // Initializes the list of orbitals to be evaluated a grid points
+		 // with subsequent orbitalValues calls.  These are also packed for 
+         // use by the block functions.
+         void setOrbitalVectors(Matrix const& coefficients, QList<int> const& indices);
+
+		 // Sets the orbitals evaluated by orbitalBlock and combinedBlock, in
+		 // place of those given to setOrbitalVectors, without copying them.
+         // The orbitals must outlive the context.
+         void setPackedOrbitals(PackedOrbitals const* orbitals);
+
+         // Returns the values of all the basis functions at the grid point.
+         Vector const& shellValues(double const x, double const y, double const z);
+
+         // Returns the values of the selected basis functions at the grid point.
+         Vector const& basisValues(double const x, double const y, double const z);
+
+         // Returns a list of the densities evaulated at the given grid point
+         Vector const& densityValues(double const x, double const y, double const z);
+
+         // Returns a list of the orbitals evaulated at the given grid point
+         Vector const& orbitalValues(double const x, double const y, double const z);
+
+		 // The block versions evaluate a batch of n points at once and return
+		 // an n x m row-major array, where m is the number of selected basis
+		 // functions, orbitals or densities, respectively.  The array remains
+		 // valid until the next call.  The basis values for the block are
+		 // formed into a matrix so that the orbitals and densities can be
+         // obtained via matrix multiplication.
+         double const* basisBlock(unsigned const n, double const* x, double const* y,
+            double const* z);
+         double const* orbitalBlock(unsigned const n, double const* x, double const* y,
+            double const* z);
+         double const* densityBlock(unsigned const n, double const* x, double const* y,
+            double const* z);
+
+		 // Returns the selected basis functions, orbitals and densities 
+		 // together, in that order, as an n x (nBasis + nOrbitals + nDensities)
+		 // array.  The shells are only evaluated once for all of these.
+         double const* combinedBlock(unsigned const n, double const* x, double const* y,
+            double const* z);
+
+      private:
+		 // Evaluates the shells that are significant anywhere in the block
+		 // and packs the values into the n x nSigBasis row-major m_block array.
+		 // The basis function index corresponding to each column is returned
+         // in m_blockBasis.  Returns the number of significant basis functions.
+         unsigned evaluateShellBlock(unsigned const n, double const* x, 
+            double const* y, double const* z);
+
+		 // These compute the values from the current block into the given
+		 // array, the rows of which are stride apart.
+         void basisColumns(unsigned const n, unsigned const nSigBas, double* values,
+            unsigned const stride);
+         void orbitalColumns(unsigned const n, unsigned const nSigBas, double* values,
+            unsigned const stride);
+         void densityColumns(unsigned const n, unsigned const nSigBas, double* values,
+            unsigned const stride);
+
+         // Density k for the current block, via the matrix or the orbitals
+         void densityFromMatrix(unsigned const n, unsigned const nSigBas, 
+            unsigned const k, double* values, unsigned const stride);
+         void densityFromOrbitals(unsigned const n, unsigned const nSigBas, 
+            unsigned const k, double* values, unsigned const stride);
+         void checkDensityPaths(unsigned const n, unsigned const nSigBas, 
+            unsigned const k);
+
+         ShellList const& m_shellList;
          unsigned m_nBasis;
-         Vector   m_overlapMatrix;   // upper triangular
 
-         // These arrays are workspace buffers for gridpoint evaluations;
-         unsigned* m_sigBasis;
-         Vector    m_basisValues;
-         Vector    m_densityValues;
-         Vector    m_orbitalValues;
+         QVector<unsigned> m_sigBasis;
+         Vector m_basisValues;
+         Vector m_selectedValues;
+         Vector m_densityValues;
+         Vector m_orbitalValues;
 
+         QList<int>           m_basisIndices;
          Matrix const*        m_orbitalCoefficients;
          QList<int>           m_orbitalIndices;
          QList<Vector const*> m_densityVectors;
-
-         Vector    m_basisPairValues;  // Deprecate
+         QVector<PackedOrbitals const*> m_densityOrbitals;
+         QVector<bool>        m_densityChecked;
+
+         // Orbitals used by the block functions
+         PackedOrbitals        m_orbitalPack;
+         PackedOrbitals const* m_orbitals;
+         unsigned              m_nOrbitals;
+
+         // Offset of the first basis function of each Shell
+         QVector<unsigned> m_shellOffsets;
+
+         QVector<double>   m_block;
+         QVector<unsigned> m_blockShells;
+         QVector<unsigned> m_blockBasis;
+         QVector<int>      m_basisColumn;
+         QVector<double>   m_gather;
+         QVector<double>   m_work;
+         QVector<double>   m_diagonal;
+         QVector<double>   m_blockValues;
+
+         // No copying allowed
+         EvaluationContext(EvaluationContext const&);
+         EvaluationContext& operator=(EvaluationContext const&);
    };
 
 } } // end namespace IQmol::Data
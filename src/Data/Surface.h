@@ -44,6 +44,7 @@ namespace Data {
          Surface() { }  // for serialization
 
          void computeSurfaceProperty(Function3D const&);
+         void computeSurfaceProperty(BlockFunction3D const&);
          void computeIndexProperty();
          void clearSurfaceProperty();
          void getPropertyRange(double& min, double& max) const;
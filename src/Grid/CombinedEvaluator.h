@@ -1,5 +1,5 @@
-#ifndef IQMOL_GRID_DENSITY_EVALUATOR_H
-#define IQMOL_GRID_DENSITY_EVALUATOR_H
+#ifndef IQMOL_GRID_COMBINED_EVALUATOR_H
+#define IQMOL_GRID_COMBINED_EVALUATOR_H
 /*******************************************************************************
          
   Copyright (C) 2011-2015 Andrew Gilbert
@@ -23,6 +23,7 @@
 ********************************************************************************/
 
 #include "GridData.h"
+#include "ShellList.h"
 #include "Function.h"
 #include "Matrix.h"
 #include "Task.h"
@@ -33,18 +34,33 @@ namespace IQmol {
    class MultiGridEvaluator;
 
    namespace Data {
-      class ShellList;
+      class Density;
+      class EvaluationContext;
    }
 
-   class DensityEvaluator : public Task {
+   /// Evaluates basis function, alpha and beta orbital and density grids of
+   /// the same size in a single pass.  The shells are only evaluated once at
+   /// each grid point with the values shared between all the grids.  The grids
+   /// must be given in the order: basis functions, alpha orbitals, beta 
+   /// orbitals and densities, with the lengths of the index and density lists
+   /// matching the number of grids of each type.  The orbital coefficients
+   /// are packed once and shared by the evaluation contexts of all the 
+   /// worker threads.
+   class CombinedEvaluator : public Task {
 
       Q_OBJECT
 
       public:
-         // Note the list of densities can be a superset of the requred densities
-         // for the grid calcualation.
-         DensityEvaluator(Data::GridDataList& grids, Data::ShellList& shellList, 
-            QList<Vector const*> const& densities);
+         CombinedEvaluator(Data::GridDataList& grids, Data::ShellList& shellList, 
+            QList<int> const& basisFunctions, 
+            Matrix const& alphaCoefficients, QList<int> const& alphaOrbitals,
+            Matrix const& betaCoefficients,  QList<int> const& betaOrbitals,
+            QList<Data::Density*> const& densities);
+
+         ~CombinedEvaluator();
+
+         /// The storage the grids are moved to once evaluated
+         void setPrecision(Data::GridData::Precision const);
 
       Q_SIGNALS:
          void progress(int);
@@ -52,16 +68,13 @@ namespace IQmol {
       protected:
          void run();
 
-      private Q_SLOTS:
-         void evaluatorFinished();
-
       private:
-         MultiFunction3D      m_function;
          Data::GridDataList   m_grids;
          Data::ShellList&     m_shellList;
-         QList<Vector const*> m_densities;
-         Vector               m_returnValues;
          MultiGridEvaluator*  m_evaluator;
+         QList<Data::EvaluationContext*> m_contexts;
+         Data::PackedOrbitals m_orbitals;
+         QList<Data::PackedOrbitals*> m_densityOrbitals;
    };
 
 } // end namespace IQmol
@@ -6,31 +6,31 @@ INCLUDEPATH += ../Util ../Data ../OpenMesh/src  ../Old
                
 
 SOURCES += \
-   $$PWD/BasisEvaluator.C \
    $$PWD/BoundingBoxDialog.C \
-   $$PWD/DensityEvaluator.C \
+   $$PWD/CombinedEvaluator.C \
+   $$PWD/GridCache.C \
    $$PWD/GridEvaluator.C \
    $$PWD/GridInfoDialog.C \
    $$PWD/Lebedev.C \
    $$PWD/MarchingCubes.C \
    $$PWD/MeshDecimator.C \
    $$PWD/MolecularGridEvaluator.C \
-   $$PWD/OrbitalEvaluator.C \
+   $$PWD/MolecularSurfaceGenerator.C \
    $$PWD/SurfaceGenerator.C \
   
 
 
 HEADERS += \
-   $$PWD/BasisEvaluator.h \
    $$PWD/BoundingBoxDialog.h \
-   $$PWD/DensityEvaluator.h \
+   $$PWD/CombinedEvaluator.h \
+   $$PWD/GridCache.h \
    $$PWD/GridEvaluator.h \
    $$PWD/GridInfoDialog.h \
    $$PWD/Lebedev.h \
    $$PWD/MarchingCubes.h \
    $$PWD/MeshDecimator.h \
    $$PWD/MolecularGridEvaluator.h \
-   $$PWD/OrbitalEvaluator.h \
+   $$PWD/MolecularSurfaceGenerator.h \
    $$PWD/SurfaceGenerator.h \
 
 FORMS += \
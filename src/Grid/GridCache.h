@@ -0,0 +1,182 @@
+#ifndef IQMOL_GRID_GRIDCACHE_H
+#define IQMOL_GRID_GRIDCACHE_H
+/*******************************************************************************
+
+  Copyright (C) 2011-2015 Andrew Gilbert
+
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software
+  Foundation, either version 3 of the License, or (at your option) any later
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************************/
+
+#include "GridData.h"
+#include <QMap>
+#include <map>
+
+
+class QTemporaryFile;
+
+namespace IQmol {
+
+   /// Owns the grids computed for the orbital and density surfaces and keeps
+   /// the memory they use within the budget set in the preferences.  Grids
+   /// are keyed on their surface type, size and the wavefunction they were
+   /// computed from and are referred to by handle rather than pointer, as
+   /// they can move.  When the budget is exceeded the least recently used
+   /// grids are either written to a compressed scratch file, from where they
+   /// are read back the next time they are asked for, or are dropped.  Space
+   /// in the scratch file freed by grids that are read back or deleted is 
+   /// reused for later grids.
+   ///
+   /// The cache is not thread safe and should only be used from the GUI
+   /// thread.  Pointers returned by grid() remain valid until the next call
+   /// that may add or restore a grid.
+   class GridCache {
+
+      public:
+		 /// Describes a cached grid, which is known without reading the grid
+		 /// back from the scratch file.
+         struct Info {
+            Info(unsigned const handle_, Data::SurfaceType const& type_,
+               Data::GridSize const& size_) : handle(handle_), type(type_),
+               size(size_), kb(0.0), spilled(false) { }
+            unsigned handle;
+            Data::SurfaceType type;
+            Data::GridSize size;
+            QList<double> isovalues;  // empty unless evaluated adaptively
+            double kb;
+            bool spilled;
+         };
+
+         typedef QList<Info> InfoList;
+
+		 /// Keeps all the grids resident for the lifetime of the object, for
+		 /// example while a batch of surfaces is generated from newly inserted
+		 /// grids.  The budget is enforced again once the last Pin goes.
+         class Pin {
+            public:
+               Pin() { GridCache::instance().pin(); }
+               ~Pin() { GridCache::instance().unpin(); }
+            private:
+               Pin(Pin const&);
+               Pin& operator=(Pin const&);
+         };
+
+         static GridCache& instance();
+
+         /// Returns a new id for use as the wavefunction part of the keys.
+         unsigned newWavefunction() { return ++m_lastWavefunction; }
+
+         /// Deletes all the grids belonging to the wavefunction.
+         void removeWavefunction(unsigned const wavefunction);
+
+		 /// Takes ownership of the grid and returns its handle.  The memory
+		 /// used by the grid is recorded here, so its precision should not be
+		 /// changed afterwards.
+         unsigned insert(unsigned const wavefunction, Data::GridData*);
+
+		 /// Returns the handle of a grid able to resolve the given isovalue or
+		 /// 0 if there is none.
+         unsigned find(unsigned const wavefunction, Data::SurfaceType const&,
+            Data::GridSize const&, double const isovalue) const;
+
+		 /// Returns the handle of a grid that was not evaluated adaptively, and
+		 /// so resolves any isovalue, or 0 if there is none.
+         unsigned findFullGrid(unsigned const wavefunction, Data::SurfaceType const&,
+            Data::GridSize const&) const;
+
+		 /// Returns the grid with the given handle, reading it back from the
+		 /// scratch file if necessary, or 0 if the grid is no longer available.
+         Data::GridData* grid(unsigned const handle);
+
+		 /// Describes all the grids belonging to the wavefunction.  Spilled
+		 /// grids stay in the scratch file, use grid() to get at the data.
+         InfoList info(unsigned const wavefunction) const;
+
+         /// Deletes the grid with the given handle.
+         void remove(unsigned const handle);
+
+         double residentKb() const { return m_residentKb; }
+
+      private:
+         struct Key {
+            Key(unsigned const wavefunction_, Data::SurfaceType const& type_,
+               Data::GridSize const& size_) : wavefunction(wavefunction_),
+               type(type_), size(size_) { }
+            bool operator<(Key const& that) const;
+
+            unsigned wavefunction;
+            Data::SurfaceType type;
+            Data::GridSize size;
+         };
+
+         struct Entry {
+            Entry(Key const& key_) : key(key_), grid(0), kb(0.0), offset(0),
+               length(0) { }
+            Key key;
+            QList<double> isovalues;
+            Data::GridData* grid;  // 0 if the grid has been spilled
+            double kb;
+            qint64 offset;
+            qint64 length;
+         };
+
+         typedef std::multimap<Key, unsigned> Index;
+
+         GridCache();
+         ~GridCache();
+
+         bool restore(Entry*);
+         bool spill(Entry*);
+         void erase(unsigned const handle);
+         void touch(unsigned const handle);
+
+         void pin() { ++m_pinned; }
+         void unpin();
+
+         /// Evicts grids, oldest first, until the resident grids fit within the
+         /// budget.  The most recently used grid is always kept, and nothing 
+         /// is evicted while the cache is pinned.
+         void trim();
+
+         qint64 allocateSlot(qint64 const length);
+         void freeSlot(qint64 offset, qint64 length);
+
+         QMap<unsigned, Entry*> m_entries;
+         Index m_index;
+
+         // Handles of the resident grids, least recently used first
+         QList<unsigned> m_recent;
+
+         double m_residentKb;
+         unsigned m_lastHandle;
+         unsigned m_lastWavefunction;
+
+         QTemporaryFile* m_spillFile;
+         int m_nSpilled;
+         int m_pinned;
+
+         // Unused regions of the scratch file, offset -> length
+         QMap<qint64, qint64> m_freeSlots;
+
+         // No copying allowed
+         GridCache(GridCache const&);
+         GridCache& operator=(GridCache const&);
+   };
+
+} // end namespace IQmol
+
+#endif
@@ -24,14 +24,13 @@
 
 #include "Task.h"
 #include "Function.h"
+#include "GridData.h"
+#include <QAtomicInt>
+#include <QVector>
 
 
 namespace IQmol {
 
-   namespace Data {
-      class GridData;
-   }
-
    class GridEvaluator : public Task {
 
       Q_OBJECT
@@ -61,16 +60,76 @@ namespace IQmol {
          MultiGridEvaluator(QList<Data::GridData*> grids, MultiFunction3D const& function,
             double const thresh, bool const coarseGrain = true);
 
+         /// Parallel version.  The grid is split into x-slabs which are run as
+         /// separate jobs on the Scheduler, with at most one job per function
+         /// queued or running at a time.  The functions are called concurrently and so
+         /// each must carry its own evaluation state.  The results are
+         /// identical to those from a single function.
+         MultiGridEvaluator(QList<Data::GridData*> grids, 
+            QList<MultiFunction3D> const& functions, double const thresh, 
+            bool const coarseGrain = true);
+
+         /// Block version of the parallel evaluator.  Grid points are passed
+         /// to the functions in batches of up to BlockSize points so that the
+         /// per-point work can be done using matrix operations.
+         MultiGridEvaluator(QList<Data::GridData*> grids, 
+            QList<MultiBlockFunction3D> const& functions, double const thresh, 
+            bool const coarseGrain = true);
+
+		 /// The grids are moved to the given storage once they have been
+		 /// evaluated, before their min/max trees are built.  The default is
+         /// to leave them in double precision.
+         void setPrecision(Data::GridData::Precision const precision) {
+            m_precision = precision;
+         }
+
+         static unsigned const BlockSize = 256;
+
+         /// Largest spacing, in grid points, used by the adaptive evaluation
+         static unsigned const MaxStride = 8;
+
       protected:
          void run();
 
       private:
-         void runCoarseGrain();
-
-         QList<Data::GridData*> m_grids;
-         MultiFunction3D const& m_function;
+         class Worker;
+         enum Pass { Full, Sparse, FillIn, Coarse, Refine };
+
+         void init();
+         void runPass(Pass const);
+         void evaluateNextSlab(Worker* worker, Scheduler::Group* group);
+         unsigned nSlabs(Pass const) const;
+         void slabFinished(Pass const);
+
+		 // If every grid has a list of target isovalues we use an adaptive
+		 // scheme.  The functions are first evaluated on a lattice with a
+		 // spacing of m_stride grid points.  The spacing is then repeatedly
+		 // halved with the new points evaluated explicitly only in cells where
+		 // the data are near one of the isovalues, and interpolated elsewhere.
+         void runAdaptive();
+         void markCells();
+         bool refineCell(unsigned const i, unsigned const j, unsigned const k) const;
+         bool needsEvaluation(unsigned const i, unsigned const j, unsigned const k) const;
+
+         QList<Data::GridData*>      m_grids;
+         QList<MultiBlockFunction3D> m_functions;
          double m_thresh;
          bool m_coarseGrain;
+         Data::GridData::Precision m_precision;
+
+         unsigned   m_nx, m_ny, m_nz;
+         Array3D    m_screen;
+
+         QAtomicInt m_nextSlab;
+         unsigned   m_nSlabs;
+         QAtomicInt m_progress;
+         QAtomicInt m_nEvaluated;
+
+         QList<QList<double> > m_isovalues;
+         unsigned m_levels;
+         unsigned m_stride;
+         unsigned m_ncx, m_ncy, m_ncz;
+         QVector<char> m_refine;
    };
 
 } // end namespace IQmol
@@ -23,7 +23,7 @@
 ********************************************************************************/
 
 #include "ui_GridInfoDialog.h"
-#include "GridData.h"
+#include "GridCache.h"
 #include <QPoint>
 
 
@@ -35,8 +35,9 @@ namespace IQmol {
 
       public:
 		 // We pass the molecule name and coordinates so that 
-		 // we can export a cube file if requested.
-         GridInfoDialog(Data::GridDataList*, QString const& moleculeName,
+		 // we can export a cube file if requested.  The grids
+		 // shown are those the GridCache holds for the wavefunction.
+         GridInfoDialog(unsigned const wavefunction, QString const& moleculeName,
             QStringList const& coordinates);
 
       Q_SIGNALS:
@@ -50,10 +51,11 @@ namespace IQmol {
 
       private:
          void exportCubeFile(bool const invertSign);
-        Data::GridDataList* m_gridDataList;
+        unsigned m_wavefunction;
+        GridCache::InfoList m_gridInfo;
         QString m_moleculeName;
         QStringList m_coordinates;
-        Data::GridDataList getSelectedGrids();
+        GridCache::InfoList getSelectedGrids();
         Ui::GridInfoDialog m_dialog;
         void loadGridInfo();
    };
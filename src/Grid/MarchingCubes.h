@@ -23,8 +23,10 @@
 ********************************************************************************/
 
 #include "Mesh.h"
+#include "Scheduler.h"
 #include "QGLViewer/vec.h"
-#include <QMap>
+#include <QAtomicInt>
+#include <QVector>
 
 
 namespace IQmol {
@@ -39,83 +41,40 @@ namespace Data {
    ///    Qt-Adaption Created on: 15.07.2009  Author: manitoo
    /// Adapted for use with precomputed grids February 2011
    /// Rewritten for Mesh support December 2013
+   ///
+   /// The grid is split into blocks of consecutive x-slabs which are marched
+   /// in parallel on the Scheduler.  Any number of isovalues can be done in
+   /// the same sweep over the grid.  Within a block the edge vertices are
+   /// shared via flat arrays indexed on (j, k, axis) which only hold the two
+   /// planes bounding the current slab.  The blocks are stitched together
+   /// where they meet and the mesh written in one go at the end.  Only the
+   /// bricks of the grid's MinMaxOctree that can contain the isosurfaces are
+   /// visited.
    class MarchingCubes : public QObject {
 
       Q_OBJECT
 
-      private:
-         // Utility class to allow for the creation of a vertex map
-         class Index {
-            public:
-               Index(unsigned const i = 0, unsigned const j = 0, unsigned const k = 0, 
-                  unsigned const direction = 0) : m_i(i), m_j(j), m_k(k), m_w(direction) { }
-
-               Index(Index const& that) { copy(that); }
-
-               Index& operator=(Index const& that) 
-               {
-                   if (this != &that) copy(that);
-                   return *this;
-               }
-
-               bool operator<(Index const& that) const
-               {
-                  if (m_i < that.m_i) return true;
-                  if (m_i > that.m_i) return false;
-
-                  if (m_j < that.m_j) return true;
-                  if (m_j > that.m_j) return false;
-
-                  if (m_k < that.m_k) return true;
-                  if (m_k > that.m_k) return false;
-
-                  return (m_w < that.m_w);
-               }
-
-               QString toString() const 
-               {
-                  QString s("(");
-                  s += QString::number(m_i);
-                  s += ",";
-                  s += QString::number(m_j);
-                  s += ",";
-                  s += QString::number(m_k);
-                  if (m_w == 0) s += " / x)";
-                  if (m_w == 1) s += " / y)";
-                  if (m_w == 2) s += " / z)";
-                  return s;
-               }
-
-            private:
-               unsigned m_i, m_j, m_k, m_w;
-
-               void copy(Index const& that) 
-               {
-                  m_i = that.m_i;  m_j = that.m_j;  m_k = that.m_k;  m_w = that.m_w;
-               }
-         };
-
-
       public:
          MarchingCubes(Data::GridData const& grid);
          void generateMesh(double const isovalue, Data::Mesh&);
 
+		 /// Generates one mesh per isovalue in a single pass over the grid,
+		 /// for example both lobes of an orbital or a stack of contours.
+         void generateMeshes(QList<double> const& isovalues, 
+            QList<Data::Mesh*> const& meshes);
+
+         void setPriority(Scheduler::Priority const priority) { m_priority = priority; }
+
 
       Q_SIGNALS:
          void progress(double);  // 0.0-1.0
 
 
       private:
-         /// Performs the Marching Cubes algorithm on a single cube.
-         void marchOnCube(int const ix, int const iy, int const iz);
-
-		 /// Finds the approximate point of intersection of the surface between
-		 /// two points with the values v1 and v2.
-         double getOffset(double const v1, double const v2);
+         class Block;
 
-         /// Adds a new vertex to the mesh
-         Data::OMMesh::VertexHandle createEdgeVertex(unsigned const edge, double const offset, 
-            qglviewer::Vec const& origin);
+         void writeMesh(QList<Block*> const& blocks, int const contour, Data::Mesh& mesh);
+         void slabFinished();
 
          // Static Data
          static const double   s_vertexOffset[8][3];
@@ -126,14 +85,19 @@ namespace Data {
          static const int      s_cubeEdgeFlags[256];
          static const int      s_triangleConnectionTable[256][16];
 
-         Data::Mesh*           m_mesh;
          Data::GridData const& m_grid;
          qglviewer::Vec const& m_origin;
          qglviewer::Vec const& m_delta;
          unsigned m_nx, m_ny, m_nz;
-         double   m_isovalue;
+         QList<double> m_isovalues;
+
+         // Bricks of the grid's min/max octree that the isovalues pass through
+         unsigned m_nBricks[3];
+         QVector<char> m_activeBricks;
 
-         QMap<Index, Data::OMMesh::VertexHandle> m_vertexMap;
+         Scheduler::Priority m_priority;
+         QAtomicInt m_slabsDone;
+         unsigned m_nSlabs;
    };
 
 } // end namespace IQmol
@@ -24,10 +24,20 @@
 
 #include "Task.h"
 #include "Mesh.h"
+#include "Scheduler.h"
 
 
 namespace IQmol {
 
+   /// Simplifies meshes using quadric error decimation, with edges not
+   /// allowed to grow beyond a threshold.  Large meshes are split into slabs
+   /// which are decimated in parallel with the vertices on the slab
+   /// boundaries locked, followed by a serial pass over the seams.
+   ///
+   /// When given a Data::Mesh, the decimation is continued on a copy of the
+   /// result to record coarser levels of detail (see 
+   /// Data::Mesh::levelsOfDetail()) which can be drawn while the view is 
+   /// being manipulated.
    class MeshDecimator {
 
       public:
@@ -35,9 +45,13 @@ namespace IQmol {
             NormalFlipping, Quadric, ProgMesh, IndependentSets, Roundness };
 
          MeshDecimator(Data::Mesh& mesh);
+         MeshDecimator(Data::Mesh& mesh1, Data::Mesh& mesh2);
          MeshDecimator(Data::OMMesh& mesh);
          MeshDecimator(Data::OMMesh& mesh1, Data::OMMesh& mesh2);
 
+         /// The priority of the jobs submitted for the partitioned meshes
+         void setPriority(Scheduler::Priority const priority) { m_priority = priority; }
+
          bool decimate(double const edgeThreshold = 0.25);
 
          QString const& error() const { return m_error; }
@@ -45,13 +59,27 @@ namespace IQmol {
          static QString toString(Algorithm const);
 
       private:
+         /// Meshes are only partitioned if each part would have at least
+         /// this number of faces.
+         static unsigned const s_minPartitionFaces;
+
+         /// Each level of detail has this fraction of the vertices of the
+         /// previous one, stopping before the number falls below the minimum.
+         static unsigned const s_levelRatio;
+         static unsigned const s_minLevelVertices;
+
           void decimateEdgeLength(Data::OMMesh&);
           void decimateAspectRatio(Data::OMMesh&);
           void decimateNormalDeviation(Data::OMMesh&);
           void decimateQuadric(Data::OMMesh& mesh);
           void decimateQuadricAndEdge(Data::OMMesh& mesh, double const edgeThreshold);
+          void decimatePartitioned(Data::Mesh& mesh, int const nPartitions, 
+             double const edgeThreshold);
+          void recordLevelsOfDetail(Data::Mesh& mesh);
 
           QList<Data::OMMesh*> m_meshes;
+          QList<Data::Mesh*> m_dataMeshes;  // null for bare OMMeshes
+          Scheduler::Priority m_priority;
           QString m_error;
    };
 
@@ -61,6 +89,11 @@ namespace IQmol {
       Q_OBJECT
 
       public:
+         MeshDecimatorTask(Data::Mesh& mesh) : m_meshDecimator(mesh) { }
+
+         MeshDecimatorTask(Data::Mesh& mesh1, Data::Mesh& mesh2) 
+          : m_meshDecimator(mesh1, mesh2) { }
+
          MeshDecimatorTask(Data::OMMesh& mesh) : m_meshDecimator(mesh) { }
 
          MeshDecimatorTask(Data::OMMesh& mesh1, Data::OMMesh& mesh2) 
@@ -69,6 +102,7 @@ namespace IQmol {
       protected:
          void run() 
          {
+            m_meshDecimator.setPriority(priority());
             if (!m_meshDecimator.decimate()) {
                setStatus(Error);
                m_info = m_meshDecimator.error();
@@ -29,6 +29,8 @@
 
 namespace IQmol {
 
+   class CombinedEvaluator;
+
    namespace Data {
       class ShellList;
       class Density;
@@ -43,8 +45,17 @@ namespace IQmol {
             Matrix const& alphaCoefficients, Matrix const& betaCoefficients, 
             QList<Data::Density*> const& densities);
 
+         ~MolecularGridEvaluator();
+
          Data::GridDataList const& getGrids() const { return m_grids; }
 
+		 /// The grids are moved to the given storage as they are completed,
+		 /// while still off the GUI thread.  This needs to be set before the
+         /// evaluator is started.
+         void setPrecision(Data::GridData::Precision const precision) {
+            m_precision = precision;
+         }
+
       Q_SIGNALS:
          void progressLabelText(QString const& label);
          void progressMaximum(int max);
@@ -53,6 +64,10 @@ namespace IQmol {
       protected:
          void run();
 
+      private Q_SLOTS:
+         void stageProgress(int done);
+         void stageFinished();
+
       private:
          Data::GridDataList m_grids;
          Data::ShellList&   m_shellList;
@@ -60,6 +75,12 @@ namespace IQmol {
          Matrix const&      m_betaCoefficients;
 
          QList<Data::Density*> m_densities;
+         Data::GridData::Precision m_precision;
+
+         // One stage for each grid size, run one after the other
+         QList<CombinedEvaluator*> m_stages;
+         int m_currentStage;
+         int m_progressOffset;
    };
 
 } // end namespace IQmol
@@ -0,0 +1,90 @@
+#ifndef IQMOL_GRID_MOLECULARSURFACEGENERATOR_H
+#define IQMOL_GRID_MOLECULARSURFACEGENERATOR_H
+/*******************************************************************************
+
+  Copyright (C) 2011-2015 Andrew Gilbert
+
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software
+  Foundation, either version 3 of the License, or (at your option) any later
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************************/
+
+#include "Task.h"
+#include "QGLViewer/vec.h"
+#include <QVector>
+
+
+namespace IQmol {
+
+namespace Data {
+   class GridData;
+   class SurfaceInfo;
+   class Surface;
+}
+
+namespace Grid {
+
+   /// Generates van der Waals, solvent accessible and solvent excluded
+   /// surfaces for a set of atomic spheres.  A signed distance to the surface
+   /// is evaluated on a grid, looking up only the nearby atoms via a cell
+   /// list, and the surface is then extracted by marching cubes, so the
+   /// result is a single closed mesh.
+   ///
+   /// For the solvent excluded surface the exposed parts of the solvent
+   /// accessible surface are sampled with probe positions.  Points inside the
+   /// accessible surface are outside the excluded surface if they lie within
+   /// a probe radius of one of these.
+   class MolecularSurfaceGenerator : public Task {
+
+      Q_OBJECT
+
+      public:
+		 /// The radii should already include any scaling.  The probe radius
+		 /// is only used for the solvent accessible and excluded surfaces.
+         /// The indices are assigned to the faces of the mesh nearest each
+         /// atom and are used for coloring by atom.
+         MolecularSurfaceGenerator(QList<qglviewer::Vec> const& centers,
+            QList<double> const& radii, QList<int> const& indices,
+            Data::SurfaceInfo const&, double const probeRadius = 1.4);
+
+         Data::Surface* getSurface() const { return m_surface; }
+
+      protected:
+         void run();
+
+      private:
+         class CellList;
+
+         void findProbes(int const begin, int const end, CellList const* atoms,
+            QVector<qglviewer::Vec>* probes) const;
+         void evaluateSlabs(unsigned const begin, unsigned const end,
+            Data::GridData* grid) const;
+         void assignFaceIndices(CellList const& atoms);
+
+         QVector<qglviewer::Vec>  m_centers;
+         QVector<double>          m_radii;   // includes the probe radius
+         QVector<int>             m_indices;
+         Data::SurfaceInfo const& m_surfaceInfo;
+         bool                     m_excluded;
+         double                   m_probeRadius;
+         double                   m_cutoff;
+         QVector<qglviewer::Vec>  m_probes;
+         Data::Surface*           m_surface;
+   };
+
+} } // end namespace IQmol::Grid
+
+#endif
@@ -45,7 +45,6 @@ namespace Layer {
 
       Q_OBJECT
 
-      using Primitive::drawLabel;
       friend class Molecule;
       friend class Bond;
       friend class Constraint;
@@ -80,7 +79,8 @@ namespace Layer {
          void draw();
          void drawFast();
          void drawSelected();
-         void drawLabel(Viewer& viewer, LabelType const, QFontMetrics&);
+         bool addToBatch(MoleculeRenderer&);
+         void addLabel(LabelRenderer&, LabelType const);
          void povray(PovRayGen&);
 
          void setAtomicNumber(unsigned int const Z);
@@ -23,6 +23,7 @@
 ********************************************************************************/
 
 #include "PrimitiveLayer.h"
+#include <QPair>
 
 
 namespace IQmol {
@@ -47,6 +48,7 @@ namespace Layer {
          void draw();
          void drawFast() { }
          void drawSelected();
+         bool addToBatch(MoleculeRenderer&);
          void setOrder(int const order) { m_order = order; }
          void setIndex(int const index);
          void povray(PovRayGen&);
@@ -60,6 +62,12 @@ namespace Layer {
          void updateOrientation();
          void drawPrivate(bool selected);
          void drawBallsAndSticks(bool selected);
+
+         typedef QList<QPair<qglviewer::Vec, GLfloat> > CylinderList;
+		 /// Returns the offsets from the bond axis and radii of the cylinders
+		 /// used to draw the bond order in BallsAndSticks mode.
+         CylinderList ballsAndSticksCylinders(GLfloat radius);
+
          void drawTubes(bool selected);
          void drawWireFrame(bool selected);
          void drawPlastic(bool selected);
@@ -47,7 +47,7 @@ namespace Layer {
          void draw();
          void drawFast() { }
          void drawSelected();
-         void drawLabel(QGLViewer& viewer, QFontMetrics& fontMetrics);
+         void addLabel(LabelRenderer&);
          void setCharge(double const charge);
 
          QString toString();
@@ -34,6 +34,8 @@ namespace IQmol {
 class ManipulatedFrameSetConstraint;
 class PovRayGen;
 class ClippingPlane;
+class MoleculeRenderer;
+class LabelRenderer;
 
 namespace Layer {
 
@@ -95,6 +97,11 @@ namespace Layer {
             glPopMatrix();
          }
 
+         /// Objects made of simple shapes, such as atoms and bonds, can add
+         /// them to the renderer to be drawn in bulk rather than through
+         /// draw().  Returns false if the object still needs drawing.
+         virtual bool addToBatch(MoleculeRenderer&) { return false; }
+
          virtual void select()   { setProperty(Selected);   }
          virtual void deselect() { unsetProperty(Selected); }
          bool isSelected() const { return hasProperty(Selected); }
@@ -137,6 +144,14 @@ namespace Layer {
             s_cameraPivot = pivot; 
          }
 
+         /// This should be called just before a draw of the whole scene.
+         /// While the view is being manipulated objects may be drawn with
+         /// less detail.
+         static void SetInteracting(bool const interacting) 
+         { 
+            s_interacting = interacting; 
+         }
+
 
       public Q_SLOTS:
          virtual void setReferenceFrame(qglviewer::Frame* frame) { 
@@ -169,6 +184,7 @@ namespace Layer {
          static qglviewer::Vec s_cameraPosition;
          static qglviewer::Vec s_cameraDirection;
          static qglviewer::Vec s_cameraPivot;
+         static bool s_interacting;
          qglviewer::Frame m_frame;
          double m_alpha;   
          GLuint m_callList;
@@ -87,12 +87,11 @@ namespace Layer {
          void initGeminalOrbitalProperties();
          void computeShellPairs(qglviewer::Vec const& gridPoint);
 
-         Data::GridData* findGrid(Data::SurfaceType const& type, 
-            Data::GridSize const& size, Data::GridDataList const& gridList);
+         // Returns the GridCache handle of the grid, or 0 if none
+         unsigned findGrid(Data::SurfaceType const& type, Data::GridSize const& size);
 
          bool processGridQueue(GridQueue const&);
          Data::Surface* generateSurface(Data::SurfaceInfo const&);
-         void dumpGridInfo() const;
          void appendSurfaces(Data::SurfaceList&);
 
          QString description(Data::SurfaceInfo const&, bool const tooltip);
@@ -106,7 +105,7 @@ namespace Layer {
          Vector m_shellValues;
 
          SurfaceInfoQueue   m_surfaceInfoQueue;
-         Data::GridDataList m_availableGrids;
+         unsigned           m_wavefunction;     // GridCache id
          qglviewer::Vec     m_bbMin, m_bbMax;   // bounding box
    };
 
@@ -28,6 +28,7 @@
 #include <QObject>
 #include <QString>
 #include <QAction>
+#include <typeinfo>
 
 
 namespace IQmol {
@@ -120,7 +121,13 @@ namespace Layer {
 
 			// We can't go both ways else we'd end up with the whole family around
             if (flags & Children) {
-               findChildren<T>(hits, flags);
+               if (flags & (Visible | SelectedOnly)) {
+                  findChildren<T>(hits, flags);
+               }else if (hits.isEmpty()) {
+                  hits = childIndex<T>(flags);
+               }else {
+                  hits += childIndex<T>(flags);
+               }
             }else if (flags & Parents)  {
                findParents<T>(hits, flags);
             }
@@ -128,6 +135,21 @@ namespace Layer {
             return hits;
          }
 
+         /// The generation is incremented whenever a row is added to or
+         /// removed from this Layer or any of its descendants.
+         unsigned generation() const { return m_generation; }
+
+		 /// Invalidates the cached child indices of this Layer and all its
+		 /// parents.  This is called by the row functions below and by the
+		 /// ViewerModel when rows are changed through the model.
+         void childrenChanged();
+
+		 /// These hide the QStandardItem versions so that the child indices
+		 /// are kept up to date.
+         void appendRow(QStandardItem* item);
+         void insertRow(int row, QStandardItem* item);
+         QList<QStandardItem*> takeRow(int row);
+
 		 /// Returns a list of actions that should appear in the context menu.
          QList<QAction*> getActions() { return m_actions; }
 
@@ -212,6 +234,57 @@ namespace Layer {
             }
          }
 
+         /// The result of findChildren for a given type and set of flags,
+         /// valid while the generation matches that of the Layer.
+         class ChildIndex {
+            public:
+               ChildIndex(std::type_info const& type_, unsigned int flags_) 
+                  : type(type_), flags(flags_), generation(0) { }
+               virtual ~ChildIndex() { }
+               std::type_info const& type;
+               unsigned int flags;
+               unsigned generation;
+         };
+
+         template <class T>
+         class TypedChildIndex : public ChildIndex {
+            public:
+               TypedChildIndex(unsigned int flags) : ChildIndex(typeid(T), flags) { }
+               QList<T*> children;
+         };
+
+		 /// Returns the cached children of a given type, rebuilding the index
+		 /// if the tree below this Layer has changed.  Only the structure of
+		 /// the tree is tracked, so this cannot be used with the Visible or
+		 /// SelectedOnly flags.
+         template <class T>
+         QList<T*> const& childIndex(unsigned int flags)
+         {
+            flags &= (Nested | Children);
+            TypedChildIndex<T>* index(0);
+
+            for (int i = 0; i < m_childIndices.size(); ++i) {
+                if (m_childIndices[i]->flags == flags && 
+                    m_childIndices[i]->type  == typeid(T)) {
+                   index = static_cast<TypedChildIndex<T>*>(m_childIndices[i]);
+                   break;
+                }
+            }
+
+            if (!index) {
+               index = new TypedChildIndex<T>(flags);
+               m_childIndices.append(index);
+            }
+
+            if (index->generation != m_generation) {
+               index->children.clear();
+               findChildren<T>(index->children, flags);
+               index->generation = m_generation;
+            }
+
+            return index->children;
+         }
+
          /// Returns a list of the parent Layers of a given type, excluding itself.
          template <class T>
          void findParents(QList<T*>& parents, unsigned int flags) 
@@ -243,6 +316,8 @@ namespace Layer {
          QList<QAction*> m_actions;
          Base* m_persistentParent;
          unsigned int m_propertyFlags;
+         unsigned m_generation;
+         QList<ChildIndex*> m_childIndices;
    };
 
    typedef QList<Layer::Base*> List;
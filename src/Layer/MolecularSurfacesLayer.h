@@ -65,7 +65,9 @@ namespace Layer {
          template <class T>
          Data::Surface* 
             calculateSuperposition(Data::SurfaceInfo const&, bool doCharges = false);
-         Data::Surface* calculateVanDerWaals(Data::SurfaceInfo const&);
+		 /// Handles the van der Waals, solvent accessible and solvent excluded
+         /// surfaces.
+         Data::Surface* calculateMolecularSurface(Data::SurfaceInfo const&);
 
          Layer::Molecule&  m_molecule;
          Configurator::MolecularSurfaces m_configurator;
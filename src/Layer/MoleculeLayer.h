@@ -36,6 +36,7 @@
 #include "Animator.h"
 #include <QFileInfo>
 #include <QMap>
+#include <QHash>
 #include <QItemSelectionModel>
 #include "boost/bind.hpp"
 #include "boost/function.hpp"
@@ -180,6 +181,8 @@ namespace IQmol {
             qglviewer::Vec centerOfNuclearCharge();
             QStringList getAvailableProperties(); 
             Function3D getPropertyEvaluator(QString const& name);
+            /// Returns an empty function if the property cannot be evaluated in blocks
+            BlockFunction3D getPropertyBlockEvaluator(QString const& name);
    
             /// Removes the specified Primitive(s) from the molecule, 
             /// but does not delete them. 
@@ -323,6 +326,10 @@ namespace IQmol {
             QList<double> zeroCharges();
             QList<double> gasteigerCharges();
 
+            /// Rebuilds the atom to bond adjacency map if the Molecule has
+            /// changed since it was last built.
+            void updateBondMap();
+
 
             /// Writes the molecule to the specified file.  The format is
             /// determined from the file extension and a Parser::IOError 
@@ -432,6 +439,9 @@ namespace IQmol {
             QAction* m_addGeometryMenu;;
 
             Matrix m_mullikenDecompositions;
+
+            QHash<Atom*, BondList> m_bondMap;
+            unsigned m_bondMapGeneration;
       };
    
    } // end namespace Layer
@@ -29,6 +29,7 @@
 #include "OrbitalsConfigurator.h"
 #include "Density.h"
 #include <QPair>
+#include <QPointer>
 
 
 class QProgressDialog;
@@ -56,7 +57,7 @@ namespace Layer {
 
       public:
          Orbitals(Data::Orbitals&);
-         ~Orbitals() { }
+         ~Orbitals();
 
          void setMolecule(Molecule* molecule);
 
@@ -95,12 +96,14 @@ namespace Layer {
          void gridEvaluatorFinished();
          void gridEvaluatorCanceled();
          void calculateSurfaces();
+         void evaluateFullGrid();
+         void fullGridFinished();
 
       private:
-         Data::GridData* findGrid(Data::SurfaceType const& type, 
-            Data::GridSize const& size, Data::GridDataList const& gridList);
+         // Returns the GridCache handle of a suitable grid, or 0 if none
+         unsigned findGrid(Data::SurfaceType const& type, 
+            Data::GridSize const& size, double const isovalue);
          Data::Surface* generateSurface(Data::SurfaceInfo const&);
-         void dumpGridInfo() const;
          void appendSurfaces(Data::SurfaceList&);
 
          virtual QString description(Data::SurfaceInfo const&, bool const tooltip);
@@ -110,10 +113,14 @@ namespace Layer {
          typedef QList<Data::SurfaceInfo> SurfaceInfoQueue;
 
          SurfaceInfoQueue        m_surfaceInfoQueue;
-         Data::GridDataList      m_availableGrids;
+         unsigned                m_wavefunction;     // GridCache id
          qglviewer::Vec          m_bbMin, m_bbMax;   // bounding box
          MolecularGridEvaluator* m_molecularGridEvaluator;
          QProgressDialog*        m_progressDialog;
+
+         // Evaluates a grid fully, without isovalues, for the surfaces waiting on it
+         MolecularGridEvaluator*  m_fullGridEvaluator;
+         QList<QPointer<Surface> > m_fullGridSurfaces;
    };
 
 } } // End namespace IQmol::Layer 
@@ -25,6 +25,7 @@
 #include "GLObjectLayer.h"
 #include "SurfaceConfigurator.h"
 #include "Surface.h"
+#include "MeshBuffer.h"
 #include <QColor>
 
 
@@ -37,6 +38,10 @@ namespace IQmol {
    class MeshDecimatorTask;
    class PovRayGen;
 
+   namespace Data {
+      class GridData;
+   }
+
    namespace Layer {
 
       /// Representation of a OpenGL surface.  Note that a surface layer is 
@@ -69,6 +74,31 @@ namespace IQmol {
             void setMolecule(Molecule*);
             void setCheckStatus(Qt::CheckState const);
 
+			/// Sets the GridCache handle of the grid the surface was generated
+			/// from, which allows the isovalue to be changed interactively for
+			/// as long as the cache holds the grid.
+            void setGrid(unsigned const gridHandle, double const isovalue);
+            unsigned gridHandle() const { return m_gridHandle; }
+
+			/// Sets a grid that is not held by the GridCache, such as the data
+			/// of a cube file.  The grid is not owned by the surface and must
+            /// outlive it.
+            void setGrid(Data::GridData const* grid, double const isovalue);
+
+			/// Replaces an adaptively evaluated grid with one evaluated over
+			/// the whole box, keeping the isovalue.  This enables the isovalue
+            /// slider if the configurator is open.
+            void setFullGrid(unsigned const gridHandle);
+
+         Q_SIGNALS:
+			/// Emitted when the configurator is opened and the grid was only
+			/// evaluated in the vicinity of the isovalue, in which case a full
+            /// grid should be passed back with setFullGrid().
+            void fullGridRequested();
+
+         public Q_SLOTS:
+            void configure();
+
          protected:
             void setColors(QList<QColor> const& colors);
             void setColors(QColor const& negative, QColor const& positive);
@@ -78,6 +108,7 @@ namespace IQmol {
             QList<QColor> const& colors() const;
 
             void computePropertyData(Function3D const&);
+            void computePropertyData(BlockFunction3D const&);
             void computeIndexField();
             void clearPropertyData();
             bool isSigned() const { return m_surface.isSigned(); }
@@ -88,6 +119,12 @@ namespace IQmol {
             double area() const { return m_surface.area(); }
             void balanceScale(bool const);
 
+            bool canChangeIsovalue() const;
+            double isovalue() const { return m_isovalue; }
+            /// Range of isovalue magnitudes that give a non-trivial surface
+            void getIsovalueRange(double& min, double& max) const;
+            void setIsovalue(double const isovalue);
+
          private Q_SLOTS:
             void toggleVertexNormals();
             void toggleFaceNormals();
@@ -96,20 +133,41 @@ namespace IQmol {
             void dumpMeshInfo() const;
    
          private:
+			/// The GL buffers are only updated on the next draw, when the
+			/// context is known to be current.  recompile() is required when
+			/// the meshes change, reloadScalarField() when the property changes
+            /// and recolor() for changes to the gradient, its range or alpha.
             void recompile();
-            GLuint compile(Data::Mesh const&);
+            void reloadScalarField();
+            void recolor();
+            void updateBuffers();
             bool isTransparent() const { return 0.01 <= m_alpha && m_alpha < 0.99; }
             void drawVertexNormals();
             void drawFaceNormals();
             void drawVertexNormals(Data::Mesh const&);
             void drawFaceNormals(Data::Mesh const&);
+
+			/// Picks the level of detail to draw while the view is being
+			/// manipulated, based on the size of the mesh on screen.
+            int levelOfDetail(MeshBuffer const&) const;
+            static double const s_pixelsPerTriangle;
+
+            /// The grid the surface was generated from, or 0 if it is gone
+            Data::GridData const* sourceGrid() const;
+
+            /// Updates the isovalue given in the tooltip after setIsovalue()
+            void updateIsovalueToolTip();
    
             Data::Surface& m_surface;
             Configurator::Surface m_configurator;
             DrawMode m_drawMode;
    
-            GLuint  m_callListPositive; 
-            GLuint  m_callListNegative; 
+            MeshBuffer m_bufferPositive; 
+            MeshBuffer m_bufferNegative; 
+            bool m_geometryChanged;
+            bool m_scalarFieldChanged;
+            bool m_colorsChanged;
+
             GLfloat m_colorPositive[4];
             GLfloat m_colorNegative[4];
 
@@ -118,6 +176,9 @@ namespace IQmol {
             bool m_balanceScale;  // for properties
 
             MeshDecimatorTask* m_decimator;
+            unsigned m_gridHandle;
+            Data::GridData const* m_grid;
+            double m_isovalue;
             void povray(PovRayGen&, Data::OMMesh const&, QColor const&);
             void povrayLines(PovRayGen&, Data::OMMesh const&, QColor const&);
       };
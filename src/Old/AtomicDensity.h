@@ -150,17 +150,8 @@ namespace IQmol {
             double density(qglviewer::Vec const&) const;
 
             double computeSignificantRadius(double const) const;
-   
-            Data::Mesh generateMesh(int nDivisions, QList<VanDerWaals*> const& atoms);
-            
+
          private:
-            static double   s_vertices[12][3];
-            static unsigned s_indices[20][3];
-   
-            void generateTriangle(Data::Mesh& mesh, 
-               Data::OMMesh::VertexHandle const& Av, Data::OMMesh::VertexHandle const& Bv, 
-               Data::OMMesh::VertexHandle const& Cv, int div);
-               
             double m_radius;
             int    m_filterLevel;
             qglviewer::Vec m_center;
@@ -26,6 +26,7 @@
 #include "Data.h"
 #include "GridData.h"
 #include "MultipoleExpansion.h"
+#include "MultipoleTree.h"
 #include "QGLViewer/vec.h"
 #include <QList>
 
@@ -54,6 +55,11 @@ namespace IQmol {
 
          virtual Function3D const& evaluator() { return m_function; }
 
+		 /// Returns an evaluator that works on blocks of points and can be
+		 /// used from several threads at once, or an empty function if the
+         /// property does not support this.
+         virtual BlockFunction3D blockEvaluator() { return BlockFunction3D(); }
+
       protected:
          Function3D m_function;
 
@@ -103,13 +109,16 @@ namespace IQmol {
             Layer::Molecule* molecule);
 
          Function3D const& evaluator();
+         BlockFunction3D blockEvaluator();
 
       private:
+         bool update();
          Layer::Molecule* m_molecule;
          Data::Type::ID m_type;
-         QList<double> m_charges;
-         QList<qglviewer::Vec> m_coordinates;
+         Util::MultipoleTree m_tree;
          double potential(double const x, double const y, double const z) const;
+         void potentialBlock(unsigned const n, double const* x, double const* y, 
+            double const* z, double* values) const;
    };
 
 
@@ -126,10 +135,20 @@ namespace IQmol {
          MultipolePotential(QString const& type, int const order, 
             Data::MultipoleExpansionList const& siteList);
 
+         Function3D const& evaluator();
+         BlockFunction3D blockEvaluator();
+
       private:
+		 /// Sites up to quadrupoles are handed to the tree, higher orders are
+         /// summed exactly.
+         bool updateTree();
          int m_order;
          Data::MultipoleExpansionList const& m_siteList;
+         Util::MultipoleTree m_tree;
          double potential(double const x, double const y, double const z) const;
+         double exactPotential(double const x, double const y, double const z) const;
+         void potentialBlock(unsigned const n, double const* x, double const* y, 
+            double const* z, double* values) const;
    };
 
 
@@ -163,9 +182,13 @@ namespace IQmol {
       public:
          GridBased(QString const& type, Data::GridData const& grid);
 
+         BlockFunction3D blockEvaluator();
+
       private:
          Data::GridData const& m_grid;
          double evaluate(double const x, double const y, double const z) const;
+         void evaluateBlock(unsigned const n, double const* x, double const* y, 
+            double const* z, double* values) const;
    };
 
 } // end namespace IQmol
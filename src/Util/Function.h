@@ -33,6 +33,18 @@ typedef boost::function<double (double const, double const, double const)> Funct
 
 typedef boost::function<Vector const& (double const, double const, double const)> MultiFunction3D;
 
+/// Evaluates several functions over a block of n points given by the x, y and
+/// z arrays.  The values are returned as an n x nFunctions row-major array
+/// which remains valid until the next call.
+typedef boost::function<double const* (unsigned const n, double const* x, 
+   double const* y, double const* z)> MultiBlockFunction3D;
+
+/// Evaluates a function at each of n points given by the x, y and z arrays,
+/// writing the results to the values array.  Unlike Function3D, these may be
+/// called concurrently on separate blocks of points.
+typedef boost::function<void (unsigned const n, double const* x, double const* y, 
+   double const* z, double* values)> BlockFunction3D;
+
 static Function3D NullFunction3D;
 
 } // end namespace IQmol
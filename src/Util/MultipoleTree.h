@@ -0,0 +1,108 @@
+#ifndef IQMOL_UTIL_MULTIPOLETREE_H
+#define IQMOL_UTIL_MULTIPOLETREE_H
+/*******************************************************************************
+
+  Copyright (C) 2011-2015 Andrew Gilbert
+
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software
+  Foundation, either version 3 of the License, or (at your option) any later
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************************/
+
+#include <QVector>
+
+
+namespace IQmol {
+namespace Util {
+
+   /// Barnes-Hut style octree for evaluating the electrostatic potential of a
+   /// large set of point multipoles (up to quadrupoles).  Each node carries
+   /// the moments of its sites about the centre of its box and, when a point
+   /// is far enough away that the truncation error (r/d)^3 falls below the
+   /// tolerance, the node is evaluated as a single multipole rather than
+   /// visiting its sites.  A tolerance of zero, or a small number of sites,
+   /// falls back to exact summation.
+   ///
+   /// The tree is unit agnostic: positions and moments need only be given
+   /// in consistent units and the potential is returned in the same units.
+   /// Once built, the evaluate functions may be called from several threads.
+   class MultipoleTree {
+
+      public:
+         struct Site {
+            Site() : charge(0.0) {
+               position[0] = position[1] = position[2] = 0.0;
+               dipole[0] = dipole[1] = dipole[2] = 0.0;
+               for (int i = 0; i < 6; ++i) quadrupole[i] = 0.0;
+            }
+            double position[3];
+            double charge;
+            double dipole[3];
+			/// Cartesian second moments ordered xx, yy, zz, xy, xz, yz.  These
+			/// need not be traceless.
+            double quadrupole[6];
+         };
+
+         MultipoleTree() : m_tolerance(0.0), m_hasDipoles(false),
+            m_hasQuadrupoles(false) { }
+
+         void build(QVector<Site> const& sites, double const tolerance);
+         void clear();
+
+         int    numberOfSites() const { return m_sites.size(); }
+         double tolerance() const { return m_tolerance; }
+
+         double evaluate(double const x, double const y, double const z) const;
+
+         /// Evaluates the potential at n points, writing to values.
+         void evaluate(unsigned const n, double const* x, double const* y,
+            double const* z, double* values) const;
+
+      private:
+         /// Below this number of sites the tree is not worth the bother
+         static int const s_minTreeSites = 64;
+         static int const s_maxLeafSites = 16;
+
+         struct Node {
+            double center[3];
+            double radius;
+            int begin, end;   // range of m_sites
+            int children[8];  // -1 if absent
+            bool leaf;
+            double charge;
+            double dipole[3];
+            double quadrupole[6];
+         };
+
+         int  buildNode(int const begin, int const end, int const depth);
+         void computeMoments(Node& node) const;
+
+         double evaluateSites(int const begin, int const end, double const x,
+            double const y, double const z) const;
+
+         void evaluateDirect(unsigned const n, double const* x, double const* y,
+            double const* z, double* values) const;
+
+         double m_tolerance;
+         bool   m_hasDipoles;
+         bool   m_hasQuadrupoles;
+         QVector<Site> m_sites;
+         QVector<Node> m_nodes;
+   };
+
+} } // end namespace IQmol::Util
+
+#endif
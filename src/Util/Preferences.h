@@ -106,6 +106,29 @@ namespace Preferences {
 
    double  SymmetryTolerance();
    void    SymmetryTolerance(double const);
+
+   /// Relative error accepted by the tree code used to evaluate electrostatic
+   /// potentials.  A value of zero forces exact (direct) summation.
+   double  ElectrostaticTolerance();
+   void    ElectrostaticTolerance(double const);
+
+   /// Storage used for computed grid data, corresponding to the values of
+   /// Data::GridData::Precision (0 = double, 1 = single, 2 = 16-bit).
+   int     GridPrecision();
+   void    GridPrecision(int const);
+
+   /// Memory, in MB, the computed grid data may occupy before the least
+   /// recently used grids are evicted from the GridCache.
+   int     GridCacheSize();
+   void    GridCacheSize(int const);
+
+   /// Whether evicted grids are kept in a scratch file rather than discarded.
+   bool    GridCacheSpill();
+   void    GridCacheSpill(bool const);
+
+   /// The number of worker threads used for the parallel grid evaluations.
+   int     NumberOfThreads();
+   void    NumberOfThreads(int const);
    
    QColor PositiveSurfaceColor();
    void   PositiveSurfaceColor(QColor const&);
@@ -0,0 +1,112 @@
+#ifndef IQMOL_UTIL_SCHEDULER_H
+#define IQMOL_UTIL_SCHEDULER_H
+/*******************************************************************************
+         
+  Copyright (C) 2011-2015 Andrew Gilbert
+      
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+         
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software  
+  Foundation, either version 3 of the License, or (at your option) any later  
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+      
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+   
+********************************************************************************/
+
+#include "boost/function.hpp"
+#include <QAtomicInt>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QList>
+#include <QVector>
+
+
+namespace IQmol {
+
+   /// A process-wide pool of worker threads for running short jobs.  Tasks
+   /// that have work that can be split up submit the pieces here rather than
+   /// creating threads of their own, so the number of busy threads stays
+   /// fixed no matter how many tasks are running.
+   ///
+   /// Each worker has its own queue.  Jobs submitted from a worker go on to
+   /// the end of its queue and are taken off the end again, while idle
+   /// workers steal from the front of the other queues.  Workers always take
+   /// the highest priority job available, so interactive work overtakes
+   /// background work as soon as the running jobs finish.  Jobs are not
+   /// interrupted, so they should be kept short.
+   class Scheduler {
+
+      public:
+         enum Priority { Background = 0, Normal, Interactive };
+
+         typedef boost::function<void ()> Job;
+
+         /// Keeps track of a set of jobs so they can be waited on.
+         class Group {
+            public:
+               Group() : m_pending(0) { }
+               bool isDone() { return m_pending.fetchAndAddOrdered(0) == 0; }
+            private:
+               friend class Scheduler;
+               QAtomicInt m_pending;
+         };
+
+         static Scheduler& instance();
+
+         void submit(Job const& job, Group& group, Priority const priority = Normal);
+
+		 /// Blocks until all the jobs in the group have been run.  If called
+		 /// from a worker, other jobs are run while waiting.
+         void wait(Group& group);
+
+         int numberOfWorkers() const { return m_workers.size(); }
+
+      private:
+         static int const NumberOfPriorities = 3;
+         class Worker;
+
+         struct Entry {
+            Job    job;
+            Group* group;
+         };
+
+         struct Queue {
+            QMutex mutex;
+            QList<Entry> entries[NumberOfPriorities];
+         };
+
+         Scheduler(int const nWorkers);
+         ~Scheduler();
+
+         int currentWorker() const;
+         bool take(int const self, Entry& entry);
+         void execute(Entry& entry);
+         void work(int const self);
+
+         QList<Worker*>  m_workers;
+         QVector<Queue*> m_queues;
+         QAtomicInt      m_nQueued;
+         QAtomicInt      m_nextQueue;
+
+         QMutex          m_mutex;
+         QWaitCondition  m_jobAvailable;
+         QWaitCondition  m_groupFinished;
+         bool            m_shutdown;
+
+         // No copying allowed
+         Scheduler(Scheduler const&);
+         Scheduler& operator=(Scheduler const&);
+   };
+
+} // end namespace IQmol
+
+#endif
@@ -22,14 +22,23 @@
    
 ********************************************************************************/
 
+#include "Scheduler.h"
 #include <QThread>
 #include <QTime>
+#include <QList>
 
 
 namespace IQmol {
 
    /// Base class for tasks that need to run in a separate thread.  If no
    /// thread is passed in the ctor, one is created and managed by the class.
+   ///
+   /// Tasks can be chained into a pipeline using addDependency(), in which
+   /// case a task is started automatically once all the tasks it depends on
+   /// have completed.  A task can also hand work off to other tasks via
+   /// addSubtask() and return from run() without waiting for them.  No
+   /// polling is involved, the bookkeeping is done by whichever thread 
+   /// finishes last.
    class Task : public QObject {
 
       Q_OBJECT
@@ -41,6 +50,7 @@ namespace IQmol {
 
          virtual ~Task() {
             m_terminate = true;
+            detach();
             if (!wait(m_timeout)) {
                m_thread->quit();
                if (!wait(m_timeout)) {
@@ -55,6 +65,10 @@ namespace IQmol {
             return m_thread->wait(time);
          }
 
+		 /// Unlike wait(), which only covers run(), this also waits for any
+		 /// subtasks to finish.  Returns false if the time runs out first.
+         bool waitUntilFinished(unsigned long time = ULONG_MAX);
+
          void msleep(unsigned long time) {
             m_thread->msleep(time);
          }
@@ -66,6 +80,23 @@ namespace IQmol {
          double  timeTaken() const { return m_time; }
          int     totalProgress() const { return m_totalProgress; }
 
+		 /// The priority with which any jobs the task submits to the
+		 /// Scheduler should be run.
+         Scheduler::Priority priority() const { return m_priority; }
+         void setPriority(Scheduler::Priority const priority) { m_priority = priority; }
+
+		 /// Delays the start of this task until the given task has completed,
+		 /// at which point it is started automatically.  If the other task
+		 /// fails or is terminated, this task is terminated without being run.
+         void addDependency(Task* task);
+
+		 /// The task is not considered finished until the subtask has
+		 /// finished.  Terminating the task also terminates the subtask, and
+		 /// the task takes on the status of the subtask if it does not
+		 /// complete successfully.  The subtask takes on the priority of the
+		 /// task, but is not started by this call.
+         void addSubtask(Task* task);
+
 
       Q_SIGNALS:
 		 /// Signals the task is no longer running, check the status to see if
@@ -78,17 +109,15 @@ namespace IQmol {
 
 
       public Q_SLOTS:
-         virtual void start() {
-            m_thread->start();
-         }
+		 /// Tasks waiting on dependencies are started when these complete,
+		 /// so calling this has no effect until then.
+         virtual void start();
 
 		 /// This simply sets the m_terminate flag and does not actually kill
 		 /// the thread.  It is up to the dervived clasess to check the value
-		 /// of the flag when appropriate and terminate cleanly.
-         virtual void stopWhatYouAreDoing() {
-            m_terminate = true;
-            setStatus(Terminated);
-         }
+		 /// of the flag when appropriate and terminate cleanly.  The flag is 
+		 /// passed on to any subtasks and tasks that depend on this one.
+         virtual void stopWhatYouAreDoing();
 
 
       protected:
@@ -109,10 +138,33 @@ namespace IQmol {
 
 
       private:
+         class GraphLocker;
+
+         void launch();
+         void complete();
+         void release(bool const announce);
+         void notify(QList<Task*> const& successors, QList<Task*> const& parents,
+            bool const announce);
+         void dependencyFinished(Task* task);
+         void subtaskFinished(Task* task);
+         void detach();
+
          Status   m_status;
          bool     m_deleteThread;
          double   m_time;
          int      m_timeout;  // in msec
+         QTime    m_timer;
+         Scheduler::Priority m_priority;
+
+         // These are protected by a mutex shared by all tasks
+         bool     m_launched;
+         bool     m_runFinished;
+         bool     m_finished;
+         QList<Task*> m_dependencies;  // still to complete
+         QList<Task*> m_successors;
+         QList<Task*> m_subtasks;      // still to finish
+         QList<Task*> m_parents;
+         QThread*     m_notifyingThread;  // set while notify() is using the task
 
          // No copying allowed
          Task(Task const&);
@@ -11,8 +11,10 @@ SOURCES = \
    $$PWD/GLShape.C \
    $$PWD/GLShapeLibrary.C \
    $$PWD/Matrix.C \
+   $$PWD/MultipoleTree.C \
    $$PWD/Preferences.C \
    $$PWD/qcprot.C \
+   $$PWD/Scheduler.C \
    $$PWD/RemoveDirectory.C \
    $$PWD/ScanDirectory.C \
    $$PWD/SetButtonColor.C \
@@ -32,10 +34,12 @@ HEADERS = \
    $$PWD/GLShape.h \
    $$PWD/GLShapeLibrary.h \
    $$PWD/Matrix.h \
+   $$PWD/MultipoleTree.h \
    $$PWD/Numerical.h \
    $$PWD/OpenGL.h \
    $$PWD/Preferences.h \
    $$PWD/qcprot.h \
+   $$PWD/Scheduler.h \
    $$PWD/RemoveDirectory.h \
    $$PWD/ScanDirectory.h \
    $$PWD/SetButtonColor.h \
@@ -0,0 +1,126 @@
+#ifndef IQMOL_VIEWER_LABELRENDERER_H
+#define IQMOL_VIEWER_LABELRENDERER_H
+/*******************************************************************************
+
+  Copyright (C) 2011-2015 Andrew Gilbert
+
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software
+  Foundation, either version 3 of the License, or (at your option) any later
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************************/
+
+#include "QGLViewer/vec.h"
+#include <QGLFunctions>
+#include <QFont>
+#include <QFontMetrics>
+#include <QHash>
+#include <QRect>
+#include <QString>
+#include <QVector>
+
+
+namespace qglviewer {
+   class Camera;
+}
+
+namespace IQmol {
+
+   /// Draws text labels anchored at points in the scene.  The glyphs of the
+   /// label font are rasterized once into an alpha texture atlas and each
+   /// frame the labels are projected to the window and expanded into one
+   /// buffer of screen-aligned quads, which is drawn with a single call.
+   /// Labels that fall outside the window, or that overlap a label closer
+   /// to the camera, are skipped.
+   class LabelRenderer : protected QGLFunctions {
+
+      public:
+         LabelRenderer();
+         ~LabelRenderer();
+
+         /// The atlas is only rebuilt if the font differs from the current one.
+         void setFont(QFont const& font);
+
+         void clear() { m_labels.clear(); }
+         bool isEmpty() const { return m_labels.isEmpty(); }
+
+         /// The label is centered horizontally on the position, which is
+         /// given in world coordinates.
+         void addLabel(qglviewer::Vec const& position, QString const& text,
+            GLfloat const* color);
+
+         /// Requires a current GL context and a camera that has been set
+         /// up for the current frame.
+         void draw(qglviewer::Camera const& camera);
+
+      private:
+         static int const s_atlasWidth;
+         static int const s_padding;
+
+         struct Label {
+            qglviewer::Vec position;
+            QString text;
+            GLubyte color[4];
+         };
+
+         // Texture coordinates of the glyph cell and the pen advance
+         struct Glyph {
+            GLfloat s0, t0, s1, t1;
+            int advance;
+         };
+
+         struct Vertex {
+            GLfloat position[3];
+            GLfloat texCoord[2];
+            GLubyte color[4];
+         };
+
+         // Projected label with the window rectangle it covers
+         struct Placement {
+            Label const* label;
+            QRect rect;
+            GLfloat depth;
+            bool operator<(Placement const& that) const { return depth < that.depth; }
+         };
+
+         void init();
+         void destroy();
+         bool addGlyphs(QString const& text);
+         void buildAtlas();
+         int textWidth(QString const& text) const;
+         bool project(Label const&, double const* matrix, int const width,
+            int const height, Placement&) const;
+         void appendQuads(Placement const&, QVector<Vertex>&) const;
+
+         QList<Label> m_labels;
+
+         QFont m_font;
+         QFontMetrics m_fontMetrics;
+         QString m_characters;
+         QHash<ushort, Glyph> m_glyphs;
+         bool m_atlasChanged;
+
+         bool m_initialized;
+         GLuint m_texture;
+         GLuint m_vertexBuffer;
+
+         // No copying allowed
+         LabelRenderer(LabelRenderer const&);
+         LabelRenderer& operator=(LabelRenderer const&);
+   };
+
+} // end namespace IQmol
+
+#endif
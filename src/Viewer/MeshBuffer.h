@@ -0,0 +1,96 @@
+#ifndef IQMOL_VIEWER_MESHBUFFER_H
+#define IQMOL_VIEWER_MESHBUFFER_H
+/*******************************************************************************
+         
+  Copyright (C) 2011-2015 Andrew Gilbert
+      
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+         
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software  
+  Foundation, either version 3 of the License, or (at your option) any later  
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+      
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+   
+********************************************************************************/
+
+#include "ColorGradient.h"
+#include "QGLViewer/vec.h"
+#include <QGLFunctions>
+#include <QVector>
+
+
+namespace IQmol {
+
+namespace Data {
+   class Mesh;
+}
+
+   /// Copy of a Mesh held in GL buffer objects.  The vertices, normals and
+   /// faces are only uploaded when the geometry changes.  Any scalar field on
+   /// the mesh is kept as one value per vertex and coloured through a lookup
+   /// table sampled from the gradient, so changing the gradient, its range or
+   /// the opacity only rewrites the colour buffer.
+   ///
+   /// Any levels of detail on the mesh get their own index buffers which
+   /// share the vertex and colour buffers.  Level 0 is the full mesh.
+   class MeshBuffer : protected QGLFunctions {
+
+      public:
+         MeshBuffer();
+         ~MeshBuffer();
+
+         /// These require a current GL context, so are best called from draw().
+         void setGeometry(Data::Mesh const&);
+         void setScalarField(Data::Mesh const&);
+         void setColors(ColorGradient::ColorList const& colors, double const min, 
+            double const max, double const alpha);
+
+         bool hasScalarField() const { return !m_scalarField.isEmpty(); }
+
+         int numberOfLevels() const { return m_nIndices.size(); }
+
+         /// Returns the finest level with no more than the given number of
+         /// triangles, or the coarsest level if there is none.
+         int levelForTriangles(double const nTriangles) const;
+
+         /// Bounding sphere of the vertices
+         qglviewer::Vec const& center() const { return m_center; }
+         double radius() const { return m_radius; }
+
+         /// Draws the triangles using the current color unless there is a
+         /// scalar field to color the vertices.
+         void draw(int const level = 0);
+
+      private:
+         static unsigned const TableSize = 256;
+
+         void init();
+         void destroy();
+         void setNumberOfLevels(int const nLevels);
+         void setIndices(int const level, QVector<GLuint> const& indices);
+
+         bool m_initialized;
+         GLuint m_vertexBuffer;   // points then normals
+         GLuint m_colorBuffer;
+         QVector<GLuint> m_indexBuffers;  // one for each level
+         QVector<GLsizei> m_nIndices;
+         GLsizei m_nVertices;
+         qglviewer::Vec m_center;
+         double m_radius;
+
+         QVector<GLfloat> m_scalarField;
+         QVector<GLubyte> m_colors;
+   };
+
+} // end namespace IQmol
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef IQMOL_VIEWER_PICKBUFFER_H
+#define IQMOL_VIEWER_PICKBUFFER_H
+/*******************************************************************************
+
+  Copyright (C) 2011-2015 Andrew Gilbert
+
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software
+  Foundation, either version 3 of the License, or (at your option) any later
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************************/
+
+#include <QGLWidget>
+#include <QRect>
+#include <QSet>
+
+
+class QGLFramebufferObject;
+
+namespace IQmol {
+
+   /// Offscreen buffer used for picking objects in the Viewer.  Each object
+   /// is drawn in a flat color that encodes its id and the ids under the
+   /// cursor or selection rectangle are then read back with glReadPixels.
+   /// The color is supplied through a 1x1 texture in GL_REPLACE mode, which
+   /// overrides any glColor calls made by the objects when drawing.
+   /// Geometry drawn before the first call to setId() keeps its own vertex
+   /// colors, which allows batched primitives to carry per-vertex ids.
+   ///
+   /// Ids are limited to 24 bits.
+   class PickBuffer {
+
+      public:
+         PickBuffer();
+         ~PickBuffer();
+
+         static bool isAvailable();
+
+         /// Redirects drawing to the buffer, resizing it if required, and
+         /// sets up the GL state for drawing ids.  Requires a current GL
+         /// context.  Returns false if the buffer could not be bound.
+         bool bind(QSize const& size);
+         void release();
+         bool isBound() const { return m_bound; }
+
+         /// Subsequent drawing will be in the color for the given id.
+         void setId(unsigned const id);
+
+         /// Sets color to the RGBA values encoding the id.
+         static void encode(unsigned const id, GLfloat* color);
+
+         /// Returns the id of the closest object drawn within the region,
+         /// given in window coordinates, or -1 if there is none.  The buffer
+         /// must be bound.
+         int closestId(QRect const& region);
+
+         /// Returns the ids of all the objects visible within the region.
+         QSet<unsigned> ids(QRect const& region);
+
+      private:
+         QRect clip(QRect const& region) const;
+
+         QGLFramebufferObject* m_buffer;
+         GLuint m_texture;
+         bool m_bound;
+
+         // No copying allowed
+         PickBuffer(PickBuffer const&);
+         PickBuffer& operator=(PickBuffer const&);
+   };
+
+} // end namespace IQmol
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef IQMOL_VIEWER_PRIMITIVEBATCH_H
+#define IQMOL_VIEWER_PRIMITIVEBATCH_H
+/*******************************************************************************
+
+  Copyright (C) 2011-2015 Andrew Gilbert
+
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software
+  Foundation, either version 3 of the License, or (at your option) any later
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************************/
+
+#include "QGLViewer/vec.h"
+#include <QGLFunctions>
+#include <QVector>
+
+
+namespace IQmol {
+
+   /// Draws many spheres or open cylinders with a single call.  Each instance
+   /// is packed into a short record (centre, radius and color for spheres;
+   /// end points, radius and color for cylinders) and the records are
+   /// collected afresh each frame.  The geometry is expanded from a unit
+   /// template into one interleaved GL buffer, but only when the records
+   /// differ from those last uploaded, so a static molecule costs a single
+   /// glDrawElements per shape.
+   ///
+   /// The template resolution follows Primitive::s_resolution, but is
+   /// lowered for large numbers of instances to keep the buffer within
+   /// s_vertexBudget vertices.
+   class PrimitiveBatch : protected QGLFunctions {
+
+      public:
+         enum Shape { Sphere, Cylinder };
+
+         PrimitiveBatch(Shape const shape);
+         ~PrimitiveBatch();
+
+         void clear() { m_records.clear(); }
+         bool isEmpty() const { return m_records.isEmpty(); }
+
+         void addSphere(qglviewer::Vec const& center, double const radius,
+            GLfloat const* color);
+         void addCylinder(qglviewer::Vec const& begin, qglviewer::Vec const& end,
+            double const radius, GLfloat const* color);
+
+         /// Requires a current GL context.
+         void draw();
+
+      private:
+         static unsigned const s_vertexBudget;
+
+         struct Vertex {
+            GLfloat position[3];
+            GLfloat normal[3];
+            GLubyte color[4];
+         };
+
+         void init();
+         void destroy();
+         void build();
+         int recordSize() const { return m_shape == Sphere ? 8 : 11; }
+         int resolutionFor(int const nInstances) const;
+         void makeTemplate(int const resolution);
+         void appendColor(GLfloat const* color);
+
+         Shape m_shape;
+         QVector<GLfloat> m_records;
+         QVector<GLfloat> m_uploaded;
+
+         // Unit sphere, or unit cylinder along z, at the current resolution
+         int m_resolution;
+         QVector<GLfloat> m_templatePoints;
+         QVector<GLfloat> m_templateNormals;
+         QVector<GLuint>  m_templateIndices;
+
+         bool m_initialized;
+         GLuint m_vertexBuffer;
+         GLuint m_indexBuffer;
+         GLsizei m_nIndices;
+
+         // No copying allowed
+         PrimitiveBatch(PrimitiveBatch const&);
+         PrimitiveBatch& operator=(PrimitiveBatch const&);
+   };
+
+
+   /// Collects the atoms and bonds of the visible molecules for drawing as
+   /// one batch per primitive type.  Cylinders whose placement depends on
+   /// the camera, such as the offset lines of multiple bonds, are kept apart
+   /// so rotating the view only rebuilds those.
+   class MoleculeRenderer {
+
+      public:
+         MoleculeRenderer() : m_spheres(PrimitiveBatch::Sphere),
+            m_cylinders(PrimitiveBatch::Cylinder),
+            m_viewCylinders(PrimitiveBatch::Cylinder), m_color(0) { }
+
+         /// If set, the color is used in place of the one passed to
+         /// addSphere() and addCylinder().  Pass 0 to unset.
+         void setColor(GLfloat const* color) { m_color = color; }
+
+         void clear()
+         {
+            m_spheres.clear();
+            m_cylinders.clear();
+            m_viewCylinders.clear();
+         }
+
+         void addSphere(qglviewer::Vec const& center, double const radius,
+            GLfloat const* color)
+         {
+            m_spheres.addSphere(center, radius, m_color ? m_color : color);
+         }
+
+         void addCylinder(qglviewer::Vec const& begin, qglviewer::Vec const& end,
+            double const radius, GLfloat const* color, bool const viewDependent = false)
+         {
+            if (m_color) color = m_color;
+            if (viewDependent) {
+               m_viewCylinders.addCylinder(begin, end, radius, color);
+            }else {
+               m_cylinders.addCylinder(begin, end, radius, color);
+            }
+         }
+
+         void draw()
+         {
+            m_spheres.draw();
+            m_cylinders.draw();
+            m_viewCylinders.draw();
+         }
+
+      private:
+         PrimitiveBatch m_spheres;
+         PrimitiveBatch m_cylinders;
+         PrimitiveBatch m_viewCylinders;
+         GLfloat const* m_color;
+   };
+
+} // end namespace IQmol
+
+#endif
@@ -35,7 +35,10 @@
 #include "ManipulateHandler.h"
 #include "ReindexAtomsHandler.h"
 #include "ManipulateSelectionHandler.h"
+#include "LabelRenderer.h"
+#include "PickBuffer.h"
 #include "Preferences.h"
+#include "PrimitiveBatch.h"
 #include "SelectHandler.h"
 #include "Snapshot.h"
 
@@ -161,6 +164,7 @@ namespace IQmol {
          void fastDraw();
          void drawGlobals();
          void drawObjects(GLObjectList const&);
+         void drawBatchedObjects(GLObjectList const&);
          void drawSelected(GLObjectList const&);
          void drawLabels(GLObjectList const&);
          void displayGeometricParameter(GLObjectList const& selection);
@@ -168,7 +172,9 @@ namespace IQmol {
          void drawWithNames(); 
 
          void drawSelectionRectangle(QRect const& rect) const;
+         void beginSelection(QPoint const&);
          void endSelection(QPoint const&);
+         void addProjectedObjects(QRect const&, QSet<unsigned>& ids);
          void postSelection(QPoint const&);
          void addToSelection(Layer::GLObject*);
          void addToSelection(int const id);
@@ -200,6 +206,10 @@ namespace IQmol {
          AnimatorList m_animatorList;
          GLObjectList m_objects;
          GLObjectList m_selectedObjects;
+         MoleculeRenderer m_moleculeRenderer;
+         MoleculeRenderer m_pickRenderer;
+         LabelRenderer m_labelRenderer;
+         PickBuffer m_pickBuffer;
 
          // State variables
          Viewer::Mode m_activeMode;
@@ -18,10 +18,14 @@ SOURCES += \
    $$PWD/CameraDialog.C \
    $$PWD/Cursors.C \
    $$PWD/GLSLmath.C \
+   $$PWD/LabelRenderer.C \
    $$PWD/ManipulateHandler.C \
    $$PWD/ManipulateSelectionHandler.C \
    $$PWD/ManipulatedFrameSetConstraint.C \
+   $$PWD/MeshBuffer.C \
+   $$PWD/PickBuffer.C \
    $$PWD/PovRayGen.C \
+   $$PWD/PrimitiveBatch.C \
    $$PWD/ReindexAtomsHandler.C \
    $$PWD/SelectHandler.C \
    $$PWD/ShaderDialog.C \
@@ -30,6 +34,7 @@ SOURCES += \
    $$PWD/Viewer.C \
    $$PWD/ViewerModel.C \
    $$PWD/ViewerModelView.C \
+   $$PWD/VisibleObjectIndex.C \
 
 
 HEADERS += \
@@ -43,10 +48,14 @@ HEADERS += \
    $$PWD/CameraDialog.h \
    $$PWD/Cursors.h \
    $$PWD/GLSLmath.h \
+   $$PWD/LabelRenderer.h \
    $$PWD/ManipulateHandler.h \
    $$PWD/ManipulateSelectionHandler.h \
    $$PWD/ManipulatedFrameSetConstraint.h \
+   $$PWD/MeshBuffer.h \
+   $$PWD/PickBuffer.h \
    $$PWD/PovRayGen.h \
+   $$PWD/PrimitiveBatch.h \
    $$PWD/ReindexAtomsHandler.h \
    $$PWD/SelectHandler.h \
    $$PWD/ShaderDialog.h \
@@ -55,6 +64,7 @@ HEADERS += \
    $$PWD/Viewer.h \
    $$PWD/ViewerModel.h \
    $$PWD/ViewerModelView.h \
+   $$PWD/VisibleObjectIndex.h \
 
 FORMS += \
    $$PWD/CameraDialog.ui \
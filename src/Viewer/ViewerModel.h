@@ -28,6 +28,7 @@
 #include "AxesLayer.h"
 #include "MoleculeLayer.h"
 #include "BackgroundLayer.h"
+#include "VisibleObjectIndex.h"
 #include <QStandardItemModel>
 #include <QItemSelection>
 #include <QList>
@@ -142,6 +143,11 @@ namespace IQmol {
       protected:
          Layer::ClippingPlane& clippingPlane() { return  m_clippingPlane; }
 
+      private Q_SLOTS:
+         void addVisibleRows(QModelIndex const& parent, int first, int last);
+         void removeVisibleRows(QModelIndex const& parent, int first, int last);
+         void layerRowsChanged(QModelIndex const& parent);
+
       private:
 		 /// Creates a new Molecule with the required connections to the
 		 /// ViewerModel, but does not append the Molecule.  In most cases the
@@ -150,6 +156,13 @@ namespace IQmol {
          void connectMolecule(Layer::Molecule*);
          void disconnectMolecule(Layer::Molecule*);
 
+		 /// The visible objects are tracked incrementally as rows are added
+		 /// to or removed from the model and as check boxes are toggled.
+		 /// Only the affected subtree is walked.
+         bool isVisible(QStandardItem*) const;
+         void addVisibleObjects(QStandardItem*);
+         void removeVisibleObjects(QStandardItem*);
+
          void processConfigData(ParseJobFiles*);
          void processParsedData(ParseJobFiles*);
 
@@ -165,7 +178,7 @@ namespace IQmol {
          Layer::Background m_background;
          Layer::ClippingPlane m_clippingPlane;
 
-         GLObjectList m_visibleObjects;
+         VisibleObjectIndex m_visibleObjects;
          GLObjectList m_selectedObjects;
          double m_symmetryTolerance;
          QString m_forceField;
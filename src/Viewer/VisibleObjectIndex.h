@@ -0,0 +1,89 @@
+#ifndef IQMOL_VIEWER_VISIBLEOBJECTINDEX_H
+#define IQMOL_VIEWER_VISIBLEOBJECTINDEX_H
+/*******************************************************************************
+
+  Copyright (C) 2011-2015 Andrew Gilbert
+
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software
+  Foundation, either version 3 of the License, or (at your option) any later
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************************/
+
+#include "GLObjectLayer.h"
+#include <QHash>
+#include <QVector>
+
+
+namespace IQmol {
+
+   /// Set of the GLObjects currently visible in the Viewer.  Objects are kept
+   /// in an opaque and a transparent bucket and can be added or removed in
+   /// constant time.  The ordered list handed to the Viewer, opaque objects
+   /// first and then the transparent ones in order of decreasing opacity, is
+   /// only rebuilt when the set has changed.
+   class VisibleObjectIndex {
+
+      public:
+         VisibleObjectIndex() : m_changed(false) { }
+
+         /// These return false if the object was already present or absent.
+         bool insert(Layer::GLObject*);
+         bool remove(Layer::GLObject*);
+
+         bool contains(Layer::GLObject* object) const
+         {
+            return m_slots.contains(object);
+         }
+
+         int size() const { return m_slots.size(); }
+         void clear();
+
+         /// Moves any objects whose opacity has changed to the other bucket.
+         /// This is linear in the number of objects, but does not touch the
+         /// ordered list unless something moves.
+         void updateOpacity();
+
+         GLObjectList const& objects();
+
+      private:
+         struct Slot {
+            Slot(bool const transparent_ = false, int const position_ = 0)
+               : transparent(transparent_), position(position_) { }
+            bool transparent;
+            int  position;
+         };
+
+         static bool isTransparent(Layer::GLObject* object)
+         {
+            return object->getAlpha() < 1.0;
+         }
+
+         QVector<Layer::GLObject*>& bucket(bool const transparent)
+         {
+            return transparent ? m_transparent : m_opaque;
+         }
+
+         QVector<Layer::GLObject*> m_opaque;
+         QVector<Layer::GLObject*> m_transparent;
+         QHash<Layer::GLObject*, Slot> m_slots;
+
+         GLObjectList m_objects;
+         bool m_changed;
+   };
+
+} // end namespace IQmol
+
+#endif